@@ -0,0 +1,240 @@
+#ifndef _ASSEMBLER_H_
+#define _ASSEMBLER_H_
+
+#include <iostream>
+#include <string>
+#include <array>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <ctime>
+
+namespace BandCHIP_Assembler
+{
+	enum class OutputType { Binary, HexASCIIString };
+	enum class ExtensionType { CHIP8, SuperCHIP10, SuperCHIP11, XOCHIP, HyperCHIP64 };
+	enum class OptimizationType { None, Peephole, Size, Speed };
+	enum class TimingType { Automatic, VIP, SuperCHIP, XOCHIP };
+	enum class BlockExitType { FallThrough, Jump, Call, Skip, Return, IndirectJump, IndirectCall, Exit, Halt };
+	enum class SymbolType { Label };
+	enum class ErrorType {
+		NoError, ReservedToken, InvalidToken, NoOperandsSupported, TooFewOperands, TooManyOperands,
+		InvalidValue, InvalidRegister, ReservedAddress, BelowCurrentAddress, Only4KBSupported,
+		SuperCHIP10Required, SuperCHIP11Required, XOCHIPRequired, HyperCHIP64Required, BinaryFileDoesNotExist,
+		ExpansionAfterSkip, ScratchRegisterRequired, CodeInRelocatableData, UnmatchedInitRegion
+       	};
+	enum class TokenType {
+		None, Instruction, Output, Extension, Align, Origin, BinaryInclude, DataByte, DataWord, Relocatable
+	};
+	enum class InstructionType {
+		None, ClearScreen, Return, Jump, Call, SkipEqual, SkipNotEqual, Load, Add, Or, And, Xor,
+		Subtract, ShiftRight, SubtractN, ShiftLeft, Random, Draw, SkipKeyPressed, SkipKeyNotPressed,
+		ScrollDown, ScrollRight, ScrollLeft, Exit, Low, High, ScrollUp, Plane, Audio, Pitch,
+		RotateRight, RotateLeft, Test, Not, Volume, Voice, Channel, Multiply, Divide, Add16,
+		MemoryCopy, MemorySet, Switch, AssertCycles, InitBegin, InitEnd
+	};
+	enum class OperandType {
+		None, Label, Register, ImmediateValue, AddressRegister, DelayTimer, SoundTimer, Pointer,
+		Key, LoResFont, HiResFont, BCD, UserRPL
+	};
+
+	struct Symbol
+	{
+		std::string Name;
+		SymbolType Type;
+		size_t Location;
+	};
+
+	struct OperandData
+	{
+		OperandType Type;
+		std::string Data;
+	};
+
+	struct InstructionData
+	{
+		InstructionType Type;
+		std::vector<OperandData> OperandList;
+		size_t OperandMinimum;
+		size_t OperandMaximum;
+	};
+
+	struct UnresolvedReferenceData
+	{
+		std::string Name;
+		size_t LineNumber;
+		unsigned short Address;
+		bool IsInstruction;
+		bool LongAddress;
+	};
+
+	struct InstructionLocationData
+	{
+		size_t Offset;
+		size_t Size;
+		size_t LineNumber;
+	};
+
+	struct CycleAssertionData
+	{
+		std::string Name;
+		size_t Maximum;
+		size_t LineNumber;
+	};
+
+	struct RegionData
+	{
+		size_t Offset;
+		size_t Size;
+		size_t LineNumber;
+	};
+
+	struct AccessExtentData
+	{
+		size_t Size;
+		bool Written;
+	};
+
+	struct OriginData
+	{
+		size_t PadOffset;
+		size_t Offset;
+	};
+
+	struct RelayoutData
+	{
+		size_t Offset;
+		size_t OldSize;
+		std::vector<unsigned char> NewData;
+		std::vector<UnresolvedReferenceData> NewReferenceList = {};
+		std::vector<InstructionLocationData> NewInstructionList = {};
+	};
+
+	struct BasicBlockData
+	{
+		size_t Offset;
+		size_t Size;
+		BlockExitType Exit;
+		std::vector<size_t> SuccessorList;
+	};
+
+	struct ObjectData
+	{
+		ExtensionType Extension;
+		OutputType Output;
+		bool Align;
+		bool Absolute;
+		std::vector<unsigned char> SectionData;
+		std::vector<Symbol> SymbolList;
+		std::vector<UnresolvedReferenceData> RelocationList;
+	};
+
+	struct DiagnosticData
+	{
+		size_t LineNumber;
+		size_t Column;
+		std::string Message;
+	};
+
+	struct BinaryFileData
+	{
+		time_t ModifiedTime;
+		size_t Size;
+		std::shared_ptr<const std::vector<unsigned char>> Data;
+	};
+
+	class BinaryFileCache
+	{
+		public:
+			std::shared_ptr<const std::vector<unsigned char>> Load(const std::string &path);
+		private:
+			std::mutex FileListMutex;
+			std::map<std::string, BinaryFileData> FileList;
+	};
+
+	class Assembler
+	{
+		public:
+			Assembler(std::ostream &log, BinaryFileCache &cache);
+			~Assembler();
+			void Reset();
+			bool SetOption(const std::string &option, const std::string &value);
+			bool Assemble(std::istream &input_file);
+			bool LoadProfile(std::istream &profile_file);
+			size_t GetErrorCount() const;
+			const std::vector<unsigned char> &GetProgramData() const;
+			std::vector<unsigned char> GetOutputData() const;
+			const std::vector<std::string> &GetDependencyList() const;
+			const std::vector<Symbol> &GetSymbolTable() const;
+			const std::vector<UnresolvedReferenceData> &GetLabelReferenceList() const;
+			const std::vector<DiagnosticData> &GetDiagnosticList() const;
+			const std::vector<InstructionLocationData> &GetInstructionLocationList() const;
+			ObjectData GetObject() const;
+			std::string GetListing() const;
+			std::vector<BasicBlockData> GetBasicBlockList() const;
+			std::string GetControlFlowGraph() const;
+			std::vector<std::pair<size_t, size_t>> GetWriteRangeList() const;
+			std::string RunProgram(unsigned long long cycle_limit) const;
+		private:
+			bool Relayout(std::vector<RelayoutData> &EditList);
+			bool RelaxReferences();
+			void ResolveReferences();
+			std::vector<size_t> GetPinnedOffsetList() const;
+			std::map<size_t, AccessExtentData> GetAccessExtentList() const;
+			bool IsMovable(const std::vector<size_t> &PinnedOffsetList, size_t offset) const;
+			std::vector<bool> GetJumpTableList() const;
+			void PlaceRelocatableData();
+			void ArrangeByProfile();
+			void DeduplicateData();
+			void PruneUnreachable();
+			void OutlineSequences();
+			void InlineSubroutines();
+			void Optimize();
+			void EvaluateInitRegions();
+			TimingType GetTiming() const;
+			bool MeasureCycles(size_t offset, size_t depth, size_t &cycles) const;
+			void CheckCycleAssertions();
+			size_t current_line_number;
+			unsigned short current_address;
+			size_t error_count;
+			std::ostream &Log;
+			BinaryFileCache &Cache;
+			static const std::array<std::string, 54> TokenList;
+			static const std::array<std::string, 2> OutputTypeList;
+			static const std::array<std::string, 5> ExtensionList;
+			static const std::array<std::string, 2> ToggleList;
+			static const std::array<std::string, 4> OptimizationList;
+			static const std::array<std::string, 4> TimingList;
+			static const std::array<std::string, 16> RegisterList;
+			OutputType CurrentOutputType;
+			ExtensionType CurrentExtension;
+			OptimizationType CurrentOptimization;
+			TimingType CurrentTiming;
+			bool align;
+			bool object_mode;
+			bool origin_used;
+			bool relocatable;
+			bool init_region;
+			bool deduplicate;
+			bool prune;
+			std::vector<Symbol> SymbolTable;
+			std::unordered_map<std::string, size_t> SymbolIndex;
+			std::unordered_map<std::string, unsigned long> ProfileIndex;
+			std::vector<UnresolvedReferenceData> UnresolvedReferenceList;
+			std::vector<UnresolvedReferenceData> LabelReferenceList;
+			std::vector<size_t> RelaxableReferenceList;
+			std::vector<OriginData> OriginList;
+			std::vector<RegionData> RelocatableList;
+			std::vector<RegionData> InitList;
+			std::vector<InstructionLocationData> InstructionLocationList;
+			std::vector<CycleAssertionData> CycleAssertionList;
+			std::vector<DiagnosticData> DiagnosticList;
+			std::vector<unsigned char> ProgramData;
+			std::vector<std::string> DependencyList;
+			std::vector<std::string> SourceLineList;
+	};
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef _INTERPRETER_H_
+#define _INTERPRETER_H_
+
+#include <array>
+#include <vector>
+#include "assembler.h"
+
+namespace BandCHIP_Assembler
+{
+	enum class InterpreterStatus { Running, Unsupported, UndefinedRead, InvalidInstruction, StackFault, Waiting, Exited };
+
+	class Interpreter
+	{
+		public:
+			Interpreter(ExtensionType extension, const std::vector<unsigned char> &ProgramData, bool isolate);
+			~Interpreter();
+			void Jump(unsigned short address);
+			bool Step();
+			void TickTimers();
+			InterpreterStatus GetStatus() const;
+			unsigned short GetProgramCounter() const;
+			unsigned short GetOpcode() const;
+			unsigned short GetAddressRegister() const;
+			const std::array<unsigned char, 16> &GetRegisterList() const;
+			bool IsRegisterSet(size_t reg) const;
+			bool IsAddressRegisterSet() const;
+			size_t GetStackDepth() const;
+			unsigned char GetDelayTimer() const;
+			unsigned char GetSoundTimer() const;
+			const std::vector<unsigned char> &GetMemory() const;
+		private:
+			bool ReadRegister(size_t reg, unsigned char &value);
+			void WriteRegister(size_t reg, unsigned char value);
+			bool ReadAddressRegister(unsigned short &value);
+			void WriteAddressRegister(unsigned short value);
+			unsigned char ReadMemory(size_t address) const;
+			void WriteMemory(size_t address, unsigned char value);
+			void Skip();
+			bool RefuseIfIsolated();
+			void Draw(size_t x, size_t y, size_t height);
+			void Scroll(long dx, long dy);
+			ExtensionType CurrentExtension;
+			InterpreterStatus status;
+			bool isolated;
+			bool high_resolution;
+			unsigned char plane_mask;
+			unsigned char delay_timer;
+			unsigned char sound_timer;
+			unsigned long random_state;
+			unsigned short program_counter;
+			unsigned short address_register;
+			unsigned char jump_register;
+			bool address_register_set;
+			std::array<unsigned char, 16> RegisterList;
+			std::array<bool, 16> RegisterSetList;
+			std::vector<unsigned short> Stack;
+			std::array<unsigned char, 16> UserFlagList;
+			std::vector<unsigned char> Memory;
+			std::vector<unsigned char> Display;
+	};
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef _JSON_H_
+#define _JSON_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace BandCHIP_Assembler
+{
+	enum class JSONType { Null, Boolean, Number, String, Array, Object };
+
+	struct JSONValue
+	{
+		JSONType Type = JSONType::Null;
+		bool Boolean = false;
+		double Number = 0.0;
+		std::string String;
+		std::vector<JSONValue> Array;
+		std::map<std::string, JSONValue> Object;
+		const JSONValue &operator[](const std::string &key) const;
+		const JSONValue &operator[](size_t index) const;
+		bool Has(const std::string &key) const;
+	};
+
+	bool ParseJSON(const std::string &text, JSONValue &value);
+	std::string WriteJSON(const JSONValue &value);
+	std::string EscapeJSONString(const std::string &text);
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef _LANGUAGE_SERVER_H_
+#define _LANGUAGE_SERVER_H_
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include "assembler.h"
+#include "json.h"
+
+namespace BandCHIP_Assembler
+{
+	struct IndexEntryData
+	{
+		std::string Name;
+		size_t Column;
+		bool IsDefinition;
+	};
+
+	struct DocumentData
+	{
+		std::vector<std::string> LineList;
+		std::vector<size_t> LineIDList;
+		std::vector<size_t> LinePositionList;
+		size_t stale_position;
+		std::vector<std::vector<IndexEntryData>> LineIndexList;
+		std::vector<size_t> FreeLineIDList;
+		std::unordered_map<std::string, std::vector<size_t>> DefinitionMap;
+		std::unordered_map<std::string, std::vector<size_t>> ReferenceMap;
+		bool diagnostics_pending;
+	};
+
+	class LanguageServer
+	{
+		public:
+			LanguageServer(BinaryFileCache &cache);
+			~LanguageServer();
+			bool Run();
+		private:
+			bool ReadMessage(std::string &content);
+			void SendMessage(const std::string &content);
+			void SendResponse(const JSONValue &id, const std::string &result);
+			void ProcessMessage(const JSONValue &message);
+			void OpenDocument(const std::string &uri, const std::string &text);
+			void ChangeDocument(DocumentData &document, const JSONValue &change);
+			void ReplaceLines(DocumentData &document, size_t first_line, size_t line_count, const std::vector<std::string> &NewLineList);
+			size_t AllocateLine(DocumentData &document);
+			void IndexLine(DocumentData &document, size_t line_id, const std::string &line);
+			void UnindexLine(DocumentData &document, size_t line_id);
+			size_t GetLinePosition(DocumentData &document, size_t line_id);
+			std::string GetNameAt(const DocumentData &document, size_t line, size_t character);
+			std::string FindLocations(const std::string &uri, DocumentData &document, const std::string &name, bool definitions, bool references);
+			void PublishDiagnostics(const std::string &uri, DocumentData &document);
+			bool InputPending();
+			BinaryFileCache &Cache;
+			std::ostringstream IndexLog;
+			Assembler IndexAssembler;
+			std::map<std::string, DocumentData> DocumentList;
+			bool shutdown;
+			const size_t MaximumMessageSize = 0x1000000;
+	};
+}
+
+#endif
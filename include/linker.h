@@ -0,0 +1,35 @@
+#ifndef _LINKER_H_
+#define _LINKER_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "assembler.h"
+#include "object.h"
+
+namespace BandCHIP_Assembler
+{
+	class Linker
+	{
+		public:
+			Linker(std::ostream &log);
+			~Linker();
+			bool AddObject(const std::string &path);
+			bool Link();
+			bool CreateArchive(std::vector<unsigned char> &archive_data);
+			size_t GetErrorCount() const;
+			std::vector<unsigned char> GetOutputData() const;
+		private:
+			std::ostream &Log;
+			size_t error_count;
+			ExtensionType CurrentExtension;
+			OutputType CurrentOutputType;
+			std::vector<std::string> ObjectPathList;
+			std::vector<ObjectData> ObjectList;
+			std::vector<std::string> ArchivePathList;
+			std::vector<ArchiveData> ArchiveList;
+			std::vector<unsigned char> ProgramData;
+	};
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef _OBJECT_H_
+#define _OBJECT_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+#include "assembler.h"
+
+namespace BandCHIP_Assembler
+{
+	struct ArchiveData
+	{
+		std::vector<std::string> MemberNameList;
+		std::vector<std::vector<unsigned char>> MemberList;
+		std::vector<std::pair<std::string, size_t>> SymbolIndex;
+	};
+
+	std::vector<unsigned char> WriteObject(const ObjectData &object);
+	bool ReadObject(const std::vector<unsigned char> &data, ObjectData &object);
+	bool IsArchive(const std::vector<unsigned char> &data);
+	std::vector<unsigned char> WriteArchive(const ArchiveData &archive);
+	bool ReadArchive(const std::vector<unsigned char> &data, ArchiveData &archive);
+	void PatchReference(std::vector<unsigned char> &Data, const UnresolvedReferenceData &reference, size_t location);
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef _REPORT_H_
+#define _REPORT_H_
+
+#include <vector>
+#include <utility>
+#include "assembler.h"
+
+namespace BandCHIP_Assembler
+{
+	std::vector<unsigned char> WriteDecodeTable(const std::vector<unsigned char> &ProgramData, const std::vector<InstructionLocationData> &InstructionList);
+	std::vector<unsigned char> WritePageMap(const std::vector<std::pair<size_t, size_t>> &WriteRangeList, size_t program_size);
+	std::vector<unsigned char> WriteBlockMap(const std::vector<BasicBlockData> &BlockList);
+}
+
+#endif
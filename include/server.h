@@ -0,0 +1,39 @@
+#ifndef _SERVER_H_
+#define _SERVER_H_
+
+#include <string>
+#include <sstream>
+#include <queue>
+#include <vector>
+#include <map>
+#include <utility>
+#include <mutex>
+#include <condition_variable>
+#include "assembler.h"
+
+namespace BandCHIP_Assembler
+{
+	class Server
+	{
+		public:
+			Server(const std::string &socket_path, BinaryFileCache &cache);
+			~Server();
+			bool Run();
+		private:
+			bool ServeRequest(int client_fd, const std::string &request, Assembler &WorkerAssembler, std::ostringstream &worker_log);
+			std::string ProcessRequest(const std::string &request, Assembler &WorkerAssembler, std::ostringstream &worker_log);
+			std::string SocketPath;
+			BinaryFileCache &Cache;
+			std::mutex ConnectionMutex;
+			std::condition_variable ConnectionCondition;
+			std::queue<std::pair<int, std::string>> ConnectionQueue;
+			std::vector<int> ReturnList;
+			std::vector<int> ActiveList;
+			bool stopping;
+			int wake_fd;
+			const size_t MaximumRequestSize = 0x1000000;
+			const int ResponseTimeout = 10000;
+	};
+}
+
+#endif
@@ -1,9 +1,17 @@
 #include "../include/application.h"
-#include <iomanip>
+#include "../include/object.h"
+#include "../include/report.h"
 #include <fstream>
-#include <sstream>
-#include <cstring>
-#include <regex>
+#include <cstdlib>
+#include <map>
+#include <algorithm>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
 
 std::ostream &BandCHIP_Assembler::operator<<(std::ostream &out, const BandCHIP_Assembler::VersionData version)
 {
@@ -11,4421 +19,198 @@ std::ostream &BandCHIP_Assembler::operator<<(std::ostream &out, const BandCHIP_A
 	return out;
 }
 
-BandCHIP_Assembler::Application::Application(int argc, char *argv[]) : current_line_number(1), current_address(0x200), error_count(0), CurrentOutputType(BandCHIP_Assembler::OutputType::Binary), CurrentExtension(BandCHIP_Assembler::ExtensionType::CHIP8), align(true), retcode(0)
+BandCHIP_Assembler::Application::Application(int argc, char *argv[]) : watch(false), object_mode(false), optimization("OFF"), deduplicate(false), prune(false), timing(""), run_cycles(0), last_output_time(0), retcode(0)
 {
-	std::cout << "BandCHIP Assembler " << Version << " - By Joshua Moss\n\n";
-	if (argc > 1)
+	for (int i = 1; i < argc; ++i)
 	{
-		for (int i = 1; i < argc; ++i)
-		{
-			Args.push_back(argv[i]);
-		}
-		std::ifstream input_file(Args[0]);
-		if (input_file.fail())
+		Args.push_back(argv[i]);
+	}
+	if (std::find(Args.begin(), Args.end(), "--lsp") != Args.end())
+	{
+		LanguageServer AssemblerLanguageServer(Cache);
+		if (!AssemblerLanguageServer.Run())
 		{
-			std::cout << "Unable to open '" << Args[0] << "'.\n\n";
-			retcode = -1;
-			return;
+			retcode = 1;
 		}
+		return;
+	}
+	std::cout << "BandCHIP Assembler " << Version << " - By Joshua Moss\n\n";
+	if (argc > 1)
+	{
 		bool output_switch = false;
-		std::ofstream output_file;
-		for (auto &i : Args)
+		bool server_switch = false;
+		for (size_t i = 0; i < Args.size(); ++i)
 		{
-			if (output_switch)
+			if (Args[i] == "-o")
 			{
-				if (i == Args[0])
+				if (i + 1 < Args.size())
 				{
-					std::cout << "Do not specify the output file as the input file.\n\n";
-					retcode = -1;
-					return;
+					output_switch = true;
+					OutputPath = Args[++i];
 				}
-				output_file.open(i, std::ios::binary);
-				std::cout << "Attempting to assemble " << Args[0] << " to " << i << "...\n";
-				break;
 			}
-			if (i == "-o")
+			else if (Args[i] == "-c")
 			{
-				output_switch = true;
+				object_mode = true;
 			}
-		}
-		if (!output_switch)
-		{
-			std::cout << "You need to specify an output file.\n\n";
-			retcode = -1;
-			return;
-		}
-		while (!input_file.fail())
-		{
-			std::array<char, 4096> line_data;
-			std::string token = "";
-			std::string u_token = "";
-			input_file.getline(line_data.data(), line_data.size(), '\n');
-			size_t characters_read = input_file.gcount();
-			bool error = false;
-			bool comment = false;
-			bool string_mode = false;
-			bool escape_mode = false;
-			bool pointer_mode = false;
-			bool long_mode = false;
-			ErrorType error_type = ErrorType::NoError;
-			TokenType token_type = TokenType::None;
-			OperandData current_operand = { OperandType::None, "" };
-			InstructionData current_instruction = { InstructionType::None, {}, 0, 0 };
-			auto OperandCountCheck = [&error, &error_type, &current_instruction]()
+			else if (Args[i] == "-O")
 			{
-				if (current_instruction.OperandList.size() > current_instruction.OperandMaximum)
-				{
-					error = true;
-					error_type = ErrorType::TooManyOperands;
-					return false;
-				}
-				else if (current_instruction.OperandList.size() < current_instruction.OperandMinimum)
-				{
-					error = true;
-					error_type = ErrorType::TooFewOperands;
-					return false;
-				}
-				return true;
-			};
-			auto ProcessLabelOperand = [this, &error, &error_type, &long_mode, &current_instruction](unsigned char operand, unsigned char opcode)
+				optimization = "ON";
+			}
+			else if (Args[i] == "-Os")
 			{
-				bool label_found = false;
-				for (auto s : SymbolTable)
-				{
-					if (s.Type == SymbolType::Label)
-					{
-						if (current_instruction.OperandList[operand].Data == s.Name)
-						{
-							label_found = true;
-							if (s.Location > 0xFFF)
-							{
-								if ((CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64) && opcode == 0xA)
-								{
-									if (long_mode)
-									{
-										ProgramData.push_back(0xF0);
-										ProgramData.push_back(0x00);
-										ProgramData.push_back(s.Location >> 8);
-										ProgramData.push_back(s.Location & 0xFF);
-										current_address += 4;
-									}
-								}
-								else
-								{
-									error = true;
-									error_type = ErrorType::Only4KBSupported;
-								}
-							}
-							ProgramData.push_back(((opcode & 0xF) << 4) | ((s.Location & 0xF00) >> 8));
-							ProgramData.push_back(s.Location & 0xFF);
-							current_address += 2;
-							if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-							{
-								error = true;
-								error_type = ErrorType::Only4KBSupported;
-								return;
-							}
-							break;
-						}
-					}
-				}
-				if (!label_found)
-				{
-					UnresolvedReferenceList.push_back({ std::move(current_instruction.OperandList[operand].Data), current_line_number, static_cast<unsigned short>(current_address - 0x200), true, (CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64) ? long_mode : false });
-					if ((CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64) && opcode == 0xA)
-					{
-						if (long_mode)
-						{
-							ProgramData.push_back(0xF0);
-							ProgramData.push_back(0x00);
-							ProgramData.push_back(0x00);
-							ProgramData.push_back(0x00);
-							current_address += 4;
-							return;
-						}
-					}
-					ProgramData.push_back((opcode & 0xF) << 4);
-					ProgramData.push_back(0x00);
-					current_address += 2;
-					if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-					{
-						error = true;
-						error_type = ErrorType::Only4KBSupported;
-						return;
-					}
-				}
-			};
-			auto ProcessAddressImmediateValueOperand = [this, &error, &error_type, &long_mode, &current_instruction](unsigned char operand, unsigned char opcode)
+				optimization = "SIZE";
+			}
+			else if (Args[i] == "-Ospeed")
 			{
-				std::regex hex("0x[a-fA-F0-9]{1,}");
-				std::regex dec("[0-9]{1,}");
-				std::smatch match;
-				unsigned short address = 0;
-				if (std::regex_search(current_instruction.OperandList[operand].Data, match, hex))
-				{
-					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-					{
-						error = true;
-						error_type = ErrorType::InvalidValue;
-						return;
-					}
-					std::istringstream hex_str(match.str());
-					hex_str >> std::hex >> address;
-				}
-				else if (std::regex_search(current_instruction.OperandList[operand].Data, match, dec))
-				{
-					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-					{
-						error = true;
-						error_type = ErrorType::InvalidValue;
-						return;
-					}
-					std::istringstream dec_str(match.str());
-					dec_str >> address;
-				}
-				if (address > 0xFFF)
-				{
-					if ((CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64) && opcode == 0xA)
-					{
-						if (long_mode)
-						{
-							ProgramData.push_back(0xF0);
-							ProgramData.push_back(0x00);
-							ProgramData.push_back(address >> 8);
-							ProgramData.push_back(address & 0xFF);
-							current_address += 4;
-						}
-					}
-					else
-					{
-						error = true;
-						error_type = ErrorType::Only4KBSupported;
-					}
-				}
-				else
-				{
-					ProgramData.push_back(((opcode & 0xF) << 4) | ((address & 0xF00) >> 8));
-					ProgramData.push_back(address & 0xFF);
-					current_address += 2;
-					if (current_address > 0xFFF && CurrentExtension != ExtensionType::HyperCHIP64)
-					{
-						error = true;
-						error_type = ErrorType::Only4KBSupported;
-						return;
-					}
-				}
-			};
-			auto Process8BitImmediateValueOperand = [this, &error, &error_type, &current_instruction](unsigned char operand)
+				optimization = "SPEED";
+			}
+			else if (Args[i] == "--dedup")
 			{
-				std::regex hex("0x[a-fA-F0-9]{1,}");
-				std::regex dec("[0-9]{1,}");
-				std::smatch match;
-				unsigned short value = 0;
-				if (std::regex_search(current_instruction.OperandList[operand].Data, match, hex))
-				{
-					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-					{
-						error = true;
-						error_type = ErrorType::InvalidValue;
-						return static_cast<unsigned char>(0x00);
-					}
-					std::istringstream hex_str(match.str());
-					hex_str >> std::hex >> value;
-				}
-				else if (std::regex_search(current_instruction.OperandList[operand].Data, match, dec))
-				{
-					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-					{
-						error = true;
-						error_type = ErrorType::InvalidValue;
-						return static_cast<unsigned char>(0x00);
-					}
-					std::istringstream dec_str(match.str());
-					dec_str >> value;
-				}
-				return static_cast<unsigned char>(value & 0xFF);
-			};
-			auto ProcessRegisterOperand = [this, &current_instruction](unsigned char operand, unsigned char &reg)
+				deduplicate = true;
+			}
+			else if (Args[i] == "--prune")
 			{
-				for (auto r : RegisterList)
-				{
-					if (r == current_instruction.OperandList[operand].Data)
-					{
-						return true;
-					}
-					if (reg < 0xF)
-					{
-						++reg;
-					}
-				}
-				return false;
-			};
-			auto ProcessAddressRegisterOffsetPointerOperand = [this, &current_instruction](unsigned char operand, unsigned char &reg)
+				prune = true;
+			}
+			else if (Args[i] == "--list")
 			{
-				std::string uptr_data = "";
-				for (size_t c = 0; c < current_instruction.OperandList[operand].Data.size(); ++c)
-				{
-					uptr_data += toupper(static_cast<unsigned char>(current_instruction.OperandList[operand].Data[c]));
-				}
-				for (auto r : RegisterList)
+				if (i + 1 < Args.size())
 				{
-					std::string ptr_reg_offstr = "I+" + r;
-					if (uptr_data == ptr_reg_offstr)
-					{
-						return true;
-					}
-					if (reg < 0xF)
-					{
-						++reg;
-					}
+					ListingPath = Args[++i];
 				}
-				return false;
-			};
-			auto ProcessOrigin = [&token, &error, &error_type]()
+			}
+			else if (Args[i] == "--cfg")
 			{
-				std::regex hex("0x[a-fA-F0-8]{1,}");
-				std::regex dec("[0-9]{1,}");
-				std::smatch match;
-				unsigned short address = 0;
-				if (std::regex_search(token, match, hex))
+				if (i + 1 < Args.size())
 				{
-					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-					{
-						error = true;
-						error_type = ErrorType::InvalidValue;
-						return static_cast<unsigned short>(0);
-					}
-					std::istringstream hex_str(match.str());
-					hex_str >> std::hex >> address;
+					GraphPath = Args[++i];
 				}
-				else if (std::regex_search(token, match, dec))
-				{
-					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-					{
-						error = true;
-						error_type = ErrorType::InvalidValue;
-						return static_cast<unsigned short>(0);
-					}
-					std::istringstream dec_str(match.str());
-					dec_str >> address;
-				}
-				return address;
-			};
-			auto ProcessDataByte = [&token, &error, &error_type]()
+			}
+			else if (Args[i] == "--block-map")
 			{
-				std::regex hex("0x[a-fA-F0-9]{1,}");
-				std::regex bin("0b[0-1]{1,8}");
-				std::regex dec("[0-9]{1,}");
-				std::smatch match;
-				unsigned short value = 0;
-				if (std::regex_search(token, match, hex))
+				if (i + 1 < Args.size())
 				{
-					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-					{
-						error = true;
-						error_type = ErrorType::InvalidValue;
-						return static_cast<unsigned char>(0);
-					}
-					std::istringstream hex_str(match.str());
-					hex_str >> std::hex >> value;
+					BlockMapPath = Args[++i];
 				}
-				else if (std::regex_search(token, match, bin))
-				{
-					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-					{
-						error = true;
-						error_type = ErrorType::InvalidValue;
-						return static_cast<unsigned char>(0);
-					}
-					for (size_t c = 0; c < match.str().size() - 2; ++c)
-					{
-						if (match.str()[2 + c] == '1')
-						{
-							value |= (0x80 >> (7 - ((match.str().size() - 3) - c)));
-						}
-					}
-				}
-				else if (std::regex_search(token, match, dec))
-				{
-					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-					{
-						error = true;
-						error_type = ErrorType::InvalidValue;
-						return static_cast<unsigned char>(0);
-					}
-					std::istringstream dec_str(match.str());
-					dec_str >> value;
-				}
-				return static_cast<unsigned char>(value & 0xFF);
-			};
-			auto ProcessDataWord = [this, &token, &error, &error_type]()
+			}
+			else if (Args[i] == "--decode")
 			{
-				unsigned short value = 0;
-				if (isdigit(static_cast<unsigned char>(token[0])))
+				if (i + 1 < Args.size())
 				{
-					std::regex hex("0x[a-fA-F0-9]{1,}");
-					std::regex bin("0b[0-1]{1,16}");
-					std::regex dec("[0-9]{1,}");
-					std::smatch match;
-					if (std::regex_search(token, match, hex))
-					{
-						if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-						{
-							error = true;
-							error_type = ErrorType::InvalidValue;
-							return static_cast<unsigned short>(0);
-						}
-						std::istringstream hex_str(match.str());
-						hex_str >> std::hex >> value;
-					}
-					else if (std::regex_search(token, match, bin))
-					{
-						if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-						{
-							error = true;
-							error_type = ErrorType::InvalidValue;
-							return static_cast<unsigned short>(0);
-						}
-						for (size_t c = 0; c < match.str().size() - 2; ++c)
-						{
-							if (match.str()[2 + c] == '1')
-							{
-								value |= (0x8000 >> (15 - ((match.str().size() - 3) - c)));
-							}
-						}
-					}
-					else if (std::regex_search(token, match, dec))
-					{
-						if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
-						{
-							error = true;
-							error_type = ErrorType::InvalidValue;
-							return static_cast<unsigned short>(0);
-						}
-						std::istringstream dec_str(match.str());
-						dec_str >> value;
-					}
+					DecodeTablePath = Args[++i];
 				}
-				else
+			}
+			else if (Args[i] == "--write-map")
+			{
+				if (i + 1 < Args.size())
 				{
-					bool symbol_found = false;
-					for (auto s : SymbolTable)
-					{
-						if (s.Type == SymbolType::Label)
-						{
-							if (token == s.Name)
-							{
-								symbol_found = true;
-								if (s.Location > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-								{
-									error = true;
-									error_type = ErrorType::Only4KBSupported;
-									return static_cast<unsigned short>(0);
-								}
-								value = s.Location;
-								break;
-							}
-						}
-					}
-					if (!symbol_found)
-					{
-						UnresolvedReferenceList.push_back({ std::move(token), current_line_number, static_cast<unsigned short>((current_address + ((align && ProgramData.size() % 2 != 0) ? 1 : 0)) - 0x200), false, false });
-					}
+					PageMapPath = Args[++i];
 				}
-				return value;
-			};
-			auto ProcessStringDataByte = [this, &error, &error_type](unsigned char data)
+			}
+			else if (Args[i] == "--profile")
 			{
-				ProgramData.push_back(data);
-				++current_address;
-				if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+				if (i + 1 < Args.size())
 				{
-					error = true;
-					error_type = ErrorType::Only4KBSupported;
+					ProfilePath = Args[++i];
 				}
-			};
-			for (size_t i = 0; i < characters_read; ++i)
+			}
+			else if (Args[i] == "--timing")
 			{
-				switch (line_data[i])
+				if (i + 1 < Args.size())
 				{
-					case '\\':
-					{
-						if (string_mode)
-						{
-							if (!escape_mode)
-							{
-								escape_mode = true;
-							}
-							else
-							{
-								switch (token_type)
-								{
-									case TokenType::Origin:
-									{
-										token += line_data[i];
-									}
-									case TokenType::DataByte:
-									{
-										ProcessStringDataByte(line_data[i]);
-										break;
-									}
-								}
-								escape_mode = false;
-							}
-						}
-						break;
-					}
-					case ';':
-					{
-						if (!string_mode)
-						{
-							if (!comment)
-							{
-								if (!pointer_mode)
-								{
-									comment = true;
-								}
-								else
-								{
-									error = true;
-								}
-							}
-						}
-						else
-						{
-							switch (token_type)
-							{
-								case TokenType::DataByte:
-								{
-									ProcessStringDataByte(line_data[i]);
-									break;
-								}
-							}
-							if (escape_mode)
-							{
-								escape_mode = false;
-							}
-						}
-						break;
-					}
-					case ' ':
-					{
-						if (!string_mode)
-						{
-							if (token.size() > 0 && !comment && !pointer_mode)
-							{
-								switch (token_type)
-								{
-									case TokenType::None:
-									{
-										bool valid_token = false;
-										for (size_t c = 0; c < token.size(); ++c)
-										{
-											u_token += toupper(static_cast<unsigned char>(token[c]));
-										}
-										for (auto t : TokenList)
-										{
-											if (u_token == t)
-											{
-												valid_token = true;
-												if (t == "OUTPUT")
-												{
-													token_type = TokenType::Output;
-												}
-												else if (t == "EXTENSION")
-												{
-													token_type = TokenType::Extension;
-												}
-												else if (t == "ALIGN")
-												{
-													token_type = TokenType::Align;
-												}
-												else if (t == "ORG")
-												{
-													token_type = TokenType::Origin;
-												}
-												else if (t == "INCBIN")
-												{
-													token_type = TokenType::BinaryInclude;
-												}
-												else if (t == "DB")
-												{
-													token_type = TokenType::DataByte;
-												}
-												else if (t == "DW")
-												{
-													token_type = TokenType::DataWord;
-												}
-												else if (t == "SCD")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::ScrollDown;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-													if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::SuperCHIP11Required;
-														break;
-													}
-												}
-												else if (t == "SCU")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::ScrollUp;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-													if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::XOCHIPRequired;
-														break;
-													}
-												}
-												else if (t == "CLS")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::ClearScreen;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-												}
-												else if (t == "RET")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Return;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-												}
-												else if (t == "SCR")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::ScrollRight;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-													if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::SuperCHIP11Required;
-														break;
-													}
-												}
-												else if (t == "SCL")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::ScrollLeft;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-													if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::SuperCHIP11Required;
-														break;
-													}
-												}
-												else if (t == "EXIT")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Exit;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-													if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::SuperCHIP10Required;
-														break;
-													}
-												}
-												else if (t == "LOW")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Low;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-													if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::SuperCHIP10Required;
-														break;
-													}
-												}
-												else if (t == "HIGH")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::High;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-													if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::SuperCHIP10Required;
-														break;
-													}
-												}
-												else if (t == "JP")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Jump;
-													current_instruction.OperandMinimum = 1;
-													current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "CALL")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Call;
-													current_instruction.OperandMinimum = 1;
-													current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "SE")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::SkipEqual;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "SNE")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::SkipNotEqual;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "LD")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Load;
-													current_instruction.OperandMinimum = 2;
-													current_instruction.OperandMaximum = 3;
-												}
-												else if (t == "ADD")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Add;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "OR")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Or;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "AND")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::And;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "XOR")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Xor;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "SUB")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Subtract;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "SHR")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::ShiftRight;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "SUBN")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::SubtractN;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "ROR")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::RotateRight;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-													if (CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::HyperCHIP64Required;
-														break;
-													}
-												}
-												else if (t == "ROL")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::RotateLeft;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-													if (CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::HyperCHIP64Required;
-														break;
-													}
-												}
-												else if (t == "TEST")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Test;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-													if (CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::HyperCHIP64Required;
-														break;
-													}
-												}
-												else if (t == "NOT")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Not;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-													if (CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::HyperCHIP64Required;
-														break;
-													}
-												}
-												else if (t == "SHL")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::ShiftLeft;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "RND")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Random;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												}
-												else if (t == "DRW")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Draw;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 3;
-												}
-												else if (t == "SKP")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::SkipKeyPressed;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												}
-												else if (t == "SKNP")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::SkipKeyNotPressed;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												}
-												else if (t == "PLANE")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Plane;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-													if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension!= ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::XOCHIPRequired;
-														break;
-													}
-												}
-												else if (t == "AUDIO")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Audio;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-													if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::XOCHIPRequired;
-														break;
-													}
-												}
-												else if (t == "PITCH")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Pitch;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-													if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::XOCHIPRequired;
-														break;
-													}
-												}
-												else if (t == "VOLUME")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Volume;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-													if (CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::HyperCHIP64Required;
-														break;
-													}
-												}
-												else if (t == "VOICE")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Voice;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-													if (CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::HyperCHIP64Required;
-														break;
-													}
-												}
-												else if (t == "CHANNEL")
-												{
-													token_type = TokenType::Instruction;
-													current_instruction.Type = InstructionType::Channel;
-													current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-													if (CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::HyperCHIP64Required;
-														break;
-													}
-												}
-												else if (t == "LONG")
-												{
-													long_mode = true;
-												}
-												token = "";
-												u_token = "";
-											}
-										}
-										if (!valid_token)
-										{
-											error = true;
-											error_type = ErrorType::InvalidToken;
-										}
-										break;
-									}
-								}
-							}
-						}
-						else
-						{
-							switch (token_type)
-							{
-								case TokenType::BinaryInclude:
-								{
-									token += line_data[i];
-								}
-								case TokenType::DataByte:
-								{
-									ProcessStringDataByte(line_data[i]);
-									break;
-								}
-							}
-							if (escape_mode)
-							{
-								escape_mode = false;
-							}
-						}
-						break;
-					}
-					case '"':
-					{
-						if (!comment)
-						{
-							if (!string_mode)
-							{
-								switch (token_type)
-								{
-									case TokenType::BinaryInclude:
-									{
-										if (token.size() > 0)
-										{
-											error = true;
-											break;
-										}
-										string_mode = true;
-										break;
-									}
-									case TokenType::DataByte:
-									{
-										string_mode = true;
-										break;
-									}
-								}
-							}
-							else
-							{
-								if (!escape_mode)
-								{
-									string_mode = false;
-								}
-								else
-								{
-									switch (token_type)
-									{
-										case TokenType::DataByte:
-										{
-											ProcessStringDataByte(line_data[i]);
-											break;
-										}
-									}
-									escape_mode = false;
-								}
-							}
-						}
-						break;
-					}
-					case '[':
-					{
-						if (!comment)
-						{
-							if (!string_mode)
-							{
-								if (current_operand.Type == OperandType::None)
-								{
-									if (!pointer_mode)
-									{
-										current_operand.Type = OperandType::Pointer;
-										pointer_mode = true;
-									}
-									else
-									{
-										error = true;
-									}
-								}
-								else
-								{
-									error = true;
-								}
-							}
-							else
-							{
-								switch (token_type)
-								{
-									case TokenType::DataByte:
-									{
-										ProcessStringDataByte(line_data[i]);
-										break;
-									}
-								}
-								if (escape_mode)
-								{
-									escape_mode = false;
-								}
-							}
-						}
-						break;
-					}
-					case ']':
-					{
-						if (!comment)
-						{
-							if (!string_mode)
-							{
-								if (current_operand.Type == OperandType::Pointer)
-								{
-									if (pointer_mode)
-									{
-										pointer_mode = false;
-									}
-									else
-									{
-										error = true;
-									}
-								}
-								else
-								{
-									error = true;
-								}
-							}
-							else
-							{
-								switch (token_type)
-								{
-									case TokenType::DataByte:
-									{
-										ProcessStringDataByte(line_data[i]);
-										break;
-									}
-								}
-								if (escape_mode)
-								{
-									escape_mode = false;
-								}
-							}
-						}
-						break;
-					}
-					case ',':
-					{
-						if (!comment)
-						{
-							for (size_t c = 0; c < token.size(); ++c)
-							{
-								u_token += toupper(static_cast<unsigned char>(token[c]));
-							}
-							switch (token_type)
-							{
-								case TokenType::Instruction:
-								{
-									if (current_operand.Type != OperandType::ImmediateValue && current_operand.Type != OperandType::Pointer)
-									{
-										bool operand_type_found = false;
-										for (auto r : RegisterList)
-										{
-											if (u_token == r)
-											{
-												operand_type_found = true;
-												token = u_token;
-												current_operand.Type = OperandType::Register;
-												break;
-											}
-										}
-										if (!operand_type_found)
-										{
-											if (u_token == "I")
-											{
-												current_operand.Type = OperandType::AddressRegister;
-											}
-											else if (u_token == "DT")
-											{
-												current_operand.Type = OperandType::DelayTimer;
-											}
-											else if (u_token == "ST")
-											{
-												current_operand.Type = OperandType::SoundTimer;
-											}
-											else if (u_token == "K")
-											{
-												current_operand.Type = OperandType::Key;
-											}
-											else if (u_token == "F")
-											{
-												current_operand.Type = OperandType::LoResFont;
-											}
-											else if (u_token == "HF")
-											{
-												current_operand.Type = OperandType::HiResFont;
-											}
-											else if (u_token == "B")
-											{
-												current_operand.Type = OperandType::BCD;
-											}
-											else if (u_token == "R")
-											{
-												current_operand.Type = OperandType::UserRPL;
-											}
-										}
-									}
-									current_operand.Data = std::move(token);
-									current_instruction.OperandList.push_back(current_operand);
-									current_operand = { OperandType::None, "" };
-									u_token = "";
-									break;
-								}
-								case TokenType::BinaryInclude:
-								{
-									if (!string_mode)
-									{
-										error = true;
-										break;
-									}
-									break;
-								}
-								case TokenType::DataByte:
-								{
-									if (!string_mode)
-									{
-										if (token.size() > 0)
-										{
-											unsigned char value = ProcessDataByte();
-											if (error)
-											{
-												break;
-											}
-											ProgramData.push_back(value);
-											if (align && ProgramData.size() % 2 != 0)
-											{
-												ProgramData.push_back(0x00);
-												current_address += 2;
-											}
-											else
-											{
-												++current_address;
-											}
-											if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-											{
-												error = true;
-												error_type = ErrorType::Only4KBSupported;
-												break;
-											}
-											token = "";
-											u_token = "";
-										}
-									}
-									else
-									{
-										ProcessStringDataByte(line_data[i]);
-										if (escape_mode)
-										{
-											escape_mode = false;
-										}
-									}
-									break;
-								}
-								case TokenType::DataWord:
-								{
-									unsigned short value = ProcessDataWord();
-									if (error)
-									{
-										break;
-									}
-									if (align && ProgramData.size() % 2 != 0)
-									{
-										ProgramData.push_back(0x00);
-										++current_address;
-										if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-										{
-											error = true;
-											error_type = ErrorType::Only4KBSupported;
-											break;
-										}
-									}
-									ProgramData.push_back(static_cast<unsigned char>(value >> 8));
-									ProgramData.push_back(static_cast<unsigned char>(value & 0xFF));
-									current_address += 2;
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-										break;
-									}
-									token = "";
-									u_token = "";
-									break;
-								}
-								default:
-								{
-									error = true;
-									break;
-								}
-							}
-						}
-						break;
-					}
-					case ':':
-					{
-						if (!comment)
-						{
-							if (!string_mode)
-							{
-								for (size_t c = 0; c < token.size(); ++c)
-								{
-									u_token += toupper(static_cast<unsigned char>(token[c]));
-								}
-								for (auto t : TokenList)
-								{
-									if (u_token == t)
-									{
-										error = true;
-										error_type = ErrorType::ReservedToken;
-										break;
-									}
-								}
-								if (error)
-								{
-									break;
-								}
-								if (u_token == "I")
-								{
-									error = true;
-									error_type = ErrorType::ReservedToken;
-									break;
-								}
-								Symbol Label = { std::move(token), SymbolType::Label, current_address };
-								SymbolTable.push_back(Label);
-								token = "";
-							}
-							else
-							{
-								switch (token_type)
-								{
-									case TokenType::BinaryInclude:
-									{
-										token += line_data[i];
-										break;
-									}
-									case TokenType::DataByte:
-									{
-										ProcessStringDataByte(line_data[i]);
-										break;
-									}
-								}
-								if (escape_mode)
-								{
-									escape_mode = false;
-								}
-							}
-						}
-						break;
-					}
-					case '\0':
-					{
-						if (string_mode)
-						{
-							error = true;
-							break;
-						}
-						if (token.size() > 0)
-						{
-							bool valid_token = false;
-							for (size_t c = 0; c < token.size(); ++c)
-							{
-								u_token += toupper(static_cast<unsigned char>(token[c]));
-							}
-							switch (token_type)
-							{
-								case TokenType::None:
-								{
-									for (auto t : TokenList)
-									{
-										if (u_token == t)
-										{
-											valid_token = true;
-											if (t == "SCD")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::ScrollDown;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::SuperCHIP11Required : ErrorType::TooFewOperands;
-											}
-											else if (t == "SCU")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::ScrollUp;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::XOCHIPRequired : ErrorType::TooFewOperands;
-											}
-											else if (t == "CLS")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::ClearScreen;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-											}
-											else if (t == "RET")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Return;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-											}
-											else if (t == "SCR")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::ScrollRight;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-												if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::SuperCHIP11Required;
-												}
-											}
-											else if (t == "SCL")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::ScrollLeft;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-												if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::SuperCHIP11Required;
-												}
-											}
-											else if (t == "EXIT")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Exit;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-												if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::SuperCHIP10Required;
-												}
-											}
-											else if (t == "LOW")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Low;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-												if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::SuperCHIP10Required;
-												}
-											}
-											else if (t == "HIGH")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::High;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-												if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::SuperCHIP10Required;
-												}
-											}
-											else if (t == "JP")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Jump;
-												current_instruction.OperandMinimum = 1;
-												current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "CALL")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Call;
-												current_instruction.OperandMinimum = 1;
-												current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "SE")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::SkipEqual;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "SNE")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::SkipNotEqual;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "LD")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Load;
-												current_instruction.OperandMinimum = 2;
-												current_instruction.OperandMaximum = 3;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "ADD")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Add;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "OR")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Or;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "AND")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::And;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "XOR")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Xor;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "SUB")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Subtract;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "SHR")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::ShiftRight;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "SUBN")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::SubtractN;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "ROR")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::RotateRight;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
-											}
-											else if (t == "ROL")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::RotateLeft;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
-											}
-											else if (t == "TEST")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Test;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
-											}
-											else if (t == "NOT")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Not;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
-											}
-											else if (t == "SHL")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::ShiftLeft;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "RND")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Random;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "DRW")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Draw;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 3;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "SKP")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::SkipKeyPressed;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "SKNP")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::SkipKeyNotPressed;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												error = true;
-												error_type = ErrorType::TooFewOperands;
-											}
-											else if (t == "PLANE")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Plane;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::XOCHIPRequired : ErrorType::TooFewOperands;
-											}
-											else if (t == "AUDIO")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Audio;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
-												if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::XOCHIPRequired;
-												}
-											}
-											else if (t == "PITCH")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Pitch;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::XOCHIPRequired : ErrorType::TooFewOperands;
-											}
-											else if (t == "VOLUME")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Volume;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
-											}
-											else if (t == "VOICE")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Voice;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
-											}
-											else if (t == "CHANNEL")
-											{
-												token_type = TokenType::Instruction;
-												current_instruction.Type = InstructionType::Channel;
-												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
-												error = true;
-												error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case TokenType::Instruction:
-								{
-									valid_token = true;
-									if (current_operand.Type != OperandType::ImmediateValue && current_operand.Type != OperandType::Pointer)
-									{
-										bool operand_type_found = false;
-										for (auto r : RegisterList)
-										{
-											if (u_token == r)
-											{
-												operand_type_found = true;
-												token = u_token;
-												current_operand.Type = OperandType::Register;
-												break;
-											}
-										}
-										if (!operand_type_found)
-										{
-											if (u_token == "I")
-											{
-												current_operand.Type = OperandType::AddressRegister;
-											}
-											else if (u_token == "DT")
-											{
-												current_operand.Type = OperandType::DelayTimer;
-											}
-											else if (u_token == "ST")
-											{
-												current_operand.Type = OperandType::SoundTimer;
-											}
-											else if (u_token == "K")
-											{
-												current_operand.Type = OperandType::Key;
-											}
-											else if (u_token == "F")
-											{
-												current_operand.Type = OperandType::LoResFont;
-											}
-											else if (u_token == "HF")
-											{
-												current_operand.Type = OperandType::HiResFont;
-											}
-											else if (u_token == "B")
-											{
-												current_operand.Type = OperandType::BCD;
-											}
-											else if (u_token == "R")
-											{
-												current_operand.Type = OperandType::UserRPL;
-											}
-											else
-											{
-												current_operand.Type = OperandType::Label;
-											}
-										}
-									}
-									current_operand.Data = std::move(token);
-									current_instruction.OperandList.push_back(current_operand);
-									break;
-								}
-								case TokenType::Output:
-								{
-									for (auto o : OutputTypeList)
-									{
-										if (u_token == o)
-										{
-											valid_token = true;
-											if (o == "BINARY")
-											{
-												CurrentOutputType = OutputType::Binary;
-												std::cout << "Using binary output mode.\n";
-											}
-											else if (o == "HEXASCIISTRING")
-											{
-												CurrentOutputType = OutputType::HexASCIIString;
-												std::cout << "Using Hex ASCII String output mode.\n";
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case TokenType::Extension:
-								{
-									for (auto e : ExtensionList)
-									{
-										if (u_token == e)
-										{
-											valid_token = true;
-											if (e == "CHIP8")
-											{
-												CurrentExtension = ExtensionType::CHIP8;
-												std::cout << "Using the original CHIP-8 instruction set.\n";
-											}
-											else if (e == "SCHIP10")
-											{
-												CurrentExtension = ExtensionType::SuperCHIP10;
-												std::cout << "Using the SuperCHIP V1.0 extension.\n";
-											}
-											else if (e == "SCHIP11")
-											{
-												CurrentExtension = ExtensionType::SuperCHIP11;
-												std::cout << "Using the SuperCHIP V1.1 extension.\n";
-											}
-											else if (e == "XOCHIP")
-											{
-												CurrentExtension = ExtensionType::XOCHIP;
-												std::cout << "Using the XO-CHIP extension.\n";
-											}
-											else if (e == "HCHIP64")
-											{
-												CurrentExtension = ExtensionType::HyperCHIP64;
-												std::cout << "Using the HyperCHIP-64 extension.\n";
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case TokenType::Align:
-								{
-									for (auto a : ToggleList)
-									{
-										if (u_token == a)
-										{
-											valid_token = true;
-											if (a == "OFF")
-											{
-												align = false;
-											}
-											else if (a == "ON")
-											{
-												align = true;
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case TokenType::Origin:
-								{
-									valid_token = true;
-									unsigned short address = ProcessOrigin();
-									if (error)
-									{
-										break;
-									}
-									if (address < 0x200)
-									{
-										error = true;
-										error_type = ErrorType::ReservedAddress;
-										break;
-									}
-									if (address < current_address)
-									{
-										error = true;
-										error_type = ErrorType::BelowCurrentAddress;
-										break;
-									}
-									current_address = address;
-									for (size_t a = ProgramData.size(); a < current_address - 0x200; ++a)
-									{
-										ProgramData.push_back(0x00);
-									}
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-										break;
-									}
-									break;
-								}
-								case TokenType::BinaryInclude:
-								{
-									valid_token = true;
-									std::ifstream binary_file(token, std::ios::binary);
-									if (binary_file.fail())
-									{
-										error = true;
-										error_type = ErrorType::BinaryFileDoesNotExist;
-										break;
-									}
-									binary_file.seekg(0, std::ios::end);
-									size_t file_size = binary_file.tellg();
-									binary_file.seekg(0, std::ios::beg);
-									for (size_t c = 0; c < file_size; ++c)
-									{
-										ProgramData.push_back(binary_file.get());
-										++current_address;
-										if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-										{
-											error = true;
-											error_type = ErrorType::Only4KBSupported;
-											break;
-										}
-									}
-									break;
-								}
-								case TokenType::DataByte:
-								{
-									valid_token = true;
-									if (token.size() > 0)
-									{
-										unsigned char value = ProcessDataByte();
-										if (error)
-										{
-											break;
-										}
-										ProgramData.push_back(value);
-										if (align && ProgramData.size() % 2 != 0)
-										{
-											ProgramData.push_back(0x00);
-											current_address += 2;
-										}
-										else
-										{
-											++current_address;
-										}
-										if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-										{
-											error = true;
-											error_type = ErrorType::Only4KBSupported;
-											break;
-										}
-									}
-									break;
-								}
-								case TokenType::DataWord:
-								{
-									valid_token = true;
-									unsigned short value = ProcessDataWord();
-									if (error)
-									{
-										break;
-									}
-									if (align && ProgramData.size() % 2 != 0)
-									{
-										ProgramData.push_back(0x00);
-										++current_address;
-										if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-										{
-											error = true;
-											error_type = ErrorType::Only4KBSupported;
-											break;
-										}
-									}
-									ProgramData.push_back(static_cast<unsigned char>(value >> 8));
-									ProgramData.push_back(static_cast<unsigned char>(value & 0xFF));
-									current_address += 2;
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-									}
-									break;
-								}
-							}
-							if (error)
-							{
-								break;
-							}
-							if (!valid_token)
-							{
-								error = true;
-								error_type = ErrorType::InvalidToken;
-								break;
-							}
-						}
-						if (token_type == TokenType::Instruction)
-						{
-							switch (current_instruction.Type)
-							{
-								case InstructionType::ScrollDown:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::ImmediateValue:
-										{
-											unsigned char value = Process8BitImmediateValueOperand(0);
-											if (error)
-											{
-												break;
-											}
-											ProgramData.push_back(0x00);
-											ProgramData.push_back(0xC0 | (value & 0xF));
-											current_address += 2;
-											if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-											{
-												error = true;
-												error_type = ErrorType::Only4KBSupported;
-												break;
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::ScrollUp:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::ImmediateValue:
-										{
-											unsigned char value = Process8BitImmediateValueOperand(0);
-											if (error)
-											{
-												break;
-											}
-											ProgramData.push_back(0x00);
-											ProgramData.push_back(0xD0 | (value & 0xF));
-											current_address += 2;
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::ClearScreen:
-								{
-									if (current_instruction.OperandList.size() > 0)
-									{
-										error = true;
-										error_type = ErrorType::NoOperandsSupported;
-										break;
-									}
-									ProgramData.push_back(0x00);
-									ProgramData.push_back(0xE0);
-									current_address += 2;
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-										break;
-									}
-									break;
-								}
-								case InstructionType::Return:
-								{
-									if (current_instruction.OperandList.size() > 0)
-									{
-										error = true;
-										error_type = ErrorType::NoOperandsSupported;
-										break;
-									}
-									ProgramData.push_back(0x00);
-									ProgramData.push_back(0xEE);
-									current_address += 2;
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-										break;
-									}
-									break;
-								}
-								case InstructionType::ScrollRight:
-								{
-									if (current_instruction.OperandList.size() > 0)
-									{
-										error = true;
-										error_type = ErrorType::NoOperandsSupported;
-										break;
-									}
-									ProgramData.push_back(0x00);
-									ProgramData.push_back(0xFB);
-									current_address += 2;
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-										break;
-									}
-									break;
-								}
-								case InstructionType::ScrollLeft:
-								{
-									if (current_instruction.OperandList.size() > 0)
-									{
-										error = true;
-										error_type = ErrorType::NoOperandsSupported;
-										break;
-									}
-									ProgramData.push_back(0x00);
-									ProgramData.push_back(0xFC);
-									current_address += 2;
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-										break;
-									}
-									break;
-								}
-								case InstructionType::Exit:
-								{
-									if (current_instruction.OperandList.size() > 0)
-									{
-										error = true;
-										error_type = ErrorType::NoOperandsSupported;
-										break;
-									}
-									ProgramData.push_back(0x00);
-									ProgramData.push_back(0xFD);
-									current_address += 2;
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-										break;
-									}
-									break;
-								}
-								case InstructionType::Low:
-								{
-									if (current_instruction.OperandList.size() > 0)
-									{
-										error = true;
-										error_type = ErrorType::NoOperandsSupported;
-										break;
-									}
-									ProgramData.push_back(0x00);
-									ProgramData.push_back(0xFE);
-									current_address += 2;
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-										break;
-									}
-									break;
-								}
-								case InstructionType::High:
-								{
-									if (current_instruction.OperandList.size() > 0)
-									{
-										error = true;
-										error_type = ErrorType::NoOperandsSupported;
-										break;
-									}
-									ProgramData.push_back(0x00);
-									ProgramData.push_back(0xFF);
-									current_address += 2;
-									if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-									{
-										error = true;
-										error_type = ErrorType::Only4KBSupported;
-										break;
-									}
-									break;
-								}
-								case InstructionType::Jump:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Label:
-										{
-											ProcessLabelOperand(0, 0x1);
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg = 0x0;
-											if (!ProcessRegisterOperand(0, reg))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (reg != 0x0 && CurrentExtension == ExtensionType::HyperCHIP64)
-											{
-												ProgramData.push_back(0xF0 | (reg & 0xF));
-												ProgramData.push_back(0xB1);
-												current_address += 2;
-											}
-											switch (current_instruction.OperandList[1].Type)
-											{
-												case OperandType::Label:
-												{
-													ProcessLabelOperand(1, 0xB);
-													break;
-												}
-												case OperandType::ImmediateValue:
-												{
-													ProcessAddressImmediateValueOperand(1, 0xB);
-													break;
-												}
-											}
-											break;
-										}
-										case OperandType::ImmediateValue:
-										{
-											ProcessAddressImmediateValueOperand(0, 0x1);
-											break;
-										}
-										case OperandType::Pointer:
-										{
-											if (CurrentExtension != ExtensionType::HyperCHIP64)
-											{
-												error = true;
-												error_type = ErrorType::HyperCHIP64Required;
-												break;
-											}
-											unsigned char reg = 0x0;
-											if (!ProcessAddressRegisterOffsetPointerOperand(0, reg))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											ProgramData.push_back(0xF0 | (reg & 0xF));
-											ProgramData.push_back(0x20);
-											current_address += 2;
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Call:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Label:
-										{
-											ProcessLabelOperand(0, 0x2);
-											break;
-										}
-										case OperandType::ImmediateValue:
-										{
-											ProcessAddressImmediateValueOperand(0, 0x2);
-											break;
-										}
-										case OperandType::Pointer:
-										{
-											unsigned char reg = 0x0;
-											if (!ProcessAddressRegisterOffsetPointerOperand(0, reg))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											ProgramData.push_back(0xF0 | (reg & 0xF));
-											ProgramData.push_back(0x21);
-											current_address += 2;
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::SkipEqual:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											switch (current_instruction.OperandList[1].Type)
-											{
-												case OperandType::Register:
-												{
-													unsigned char reg2 = 0x0;
-													if (!ProcessRegisterOperand(1, reg2))
-													{
-														error = true;
-														error_type = ErrorType::InvalidRegister;
-														break;
-													}
-													ProgramData.push_back(0x50 | (reg1 & 0xF));
-													ProgramData.push_back(reg2 << 4);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-												case OperandType::ImmediateValue:
-												{
-													unsigned char value = Process8BitImmediateValueOperand(1);
-													if (error)
-													{
-														break;
-													}
-													ProgramData.push_back(0x30 | (reg1 & 0xF));
-													ProgramData.push_back(value);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::SkipNotEqual:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											switch (current_instruction.OperandList[1].Type)
-											{
-												case OperandType::Register:
-												{
-														unsigned char reg2 = 0x0;
-													if (!ProcessRegisterOperand(0, reg2))
-													{
-														error = true;
-														error_type = ErrorType::InvalidRegister;
-														break;
-													}
-													ProgramData.push_back(0x90 | (reg1 & 0xF));
-													ProgramData.push_back(reg2 << 4);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-												case OperandType::ImmediateValue:
-												{
-													unsigned char value = Process8BitImmediateValueOperand(1);
-													if (error)
-													{
-														break;
-													}
-													ProgramData.push_back(0x40 | (reg1 & 0xF));
-													ProgramData.push_back(value);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Load:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											switch (current_instruction.OperandList[1].Type)
-											{
-												case OperandType::Register:
-												{
-													unsigned char reg2 = 0x0;
-													if (!ProcessRegisterOperand(1, reg2))
-													{
-														error = true;
-														error_type = ErrorType::InvalidRegister;
-														break;
-													}
-													if (current_instruction.OperandList.size() == 2)
-													{
-														ProgramData.push_back(0x80 | (reg1 & 0xF));
-														ProgramData.push_back(reg2 << 4);
-													}
-													else
-													{
-														if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-														{
-															error = true;
-															error_type = ErrorType::XOCHIPRequired;
-															break;
-														}
-														if (current_instruction.OperandList[2].Type == OperandType::Pointer)
-														{
-															std::string uptr_data;
-															for (size_t c = 0; c < current_instruction.OperandList[2].Data.size(); ++c)
-															{
-																uptr_data += toupper(static_cast<unsigned char>(current_instruction.OperandList[2].Data[c]));
-															}
-															if (uptr_data == "I")
-															{
-																ProgramData.push_back(0x50 | (reg1 & 0xF));
-																ProgramData.push_back((reg2 << 4) | 0x3);
-															}
-														}
-													}
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-												case OperandType::ImmediateValue:
-												{
-													unsigned char value = Process8BitImmediateValueOperand(1);
-													if (error)
-													{
-														break;
-													}
-													ProgramData.push_back(0x60 | (reg1 & 0xF));
-													ProgramData.push_back(value);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-												case OperandType::DelayTimer:
-												{
-													ProgramData.push_back(0xF0 | (reg1 & 0xF));
-													ProgramData.push_back(0x07);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-												case OperandType::Pointer:
-												{
-													std::string uptr_data;
-													for (size_t c = 0; c < current_instruction.OperandList[1].Data.size(); ++c)
-													{
-														uptr_data += toupper(static_cast<unsigned char>(current_instruction.OperandList[1].Data[c]));
-													}
-													if (uptr_data == "I")
-													{
-														ProgramData.push_back(0xF0 | (reg1 & 0xF));
-														ProgramData.push_back(0x65);
-														current_address += 2;
-														if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-														{
-															error = true;
-															error_type = ErrorType::Only4KBSupported;
-															break;
-														}
-													}
-													break;
-												}
-												case OperandType::Key:
-												{
-													ProgramData.push_back(0xF0 | (reg1 & 0xF));
-													ProgramData.push_back(0x0A);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-												case OperandType::UserRPL:
-												{
-													if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)														
-													{
-														error = true;
-														error_type = ErrorType::SuperCHIP10Required;
-														break;
-													}
-													ProgramData.push_back(0xF0 | (reg1 & 0xF));
-													ProgramData.push_back(0x85);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-											}
-											break;
-										}
-										case OperandType::AddressRegister:
-										{
-											switch (current_instruction.OperandList[1].Type)
-											{
-												case OperandType::Label:
-												{
-													ProcessLabelOperand(1, 0xA);
-													break;
-												}
-												case OperandType::ImmediateValue:
-												{
-													ProcessAddressImmediateValueOperand(1, 0xA);
-													break;
-												}
-												case OperandType::Pointer:
-												{
-													if (CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::HyperCHIP64Required;
-														break;
-													}
-													unsigned char reg = 0x0;
-													if (!ProcessAddressRegisterOffsetPointerOperand(1, reg))
-													{
-														error = true;
-														error_type = ErrorType::InvalidRegister;
-														break;
-													}
-													ProgramData.push_back(0xF0 | (reg & 0xF));
-													ProgramData.push_back(0xA2);
-													current_address += 2;
-													break;
-												}
-											}
-											break;
-										}
-										case OperandType::DelayTimer:
-										{
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg = 0x0;
-												if (!ProcessRegisterOperand(1, reg))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0xF0 | (reg & 0xF));
-												ProgramData.push_back(0x15);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-										case OperandType::SoundTimer:
-										{
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg = 0x0;
-												if (!ProcessRegisterOperand(1, reg))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0xF0 | (reg & 0xF));
-												ProgramData.push_back(0x18);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-										case OperandType::Pointer:
-										{
-											std::string uptr_data;
-											for (size_t c = 0; c < current_instruction.OperandList[0].Data.size(); ++c)
-											{
-												uptr_data += toupper(static_cast<unsigned char>(current_instruction.OperandList[0].Data[c]));
-											}
-											if (uptr_data == "I")
-											{
-												if (current_instruction.OperandList[1].Type == OperandType::Register)
-												{
-													unsigned char reg1 = 0x0;
-													if (!ProcessRegisterOperand(1, reg1))
-													{
-														error = true;
-														error_type = ErrorType::InvalidRegister;
-														break;
-													}
-													if (current_instruction.OperandList.size() == 2)
-													{
-														ProgramData.push_back(0xF0 | (reg1 & 0xF));
-														ProgramData.push_back(0x55);
-													}
-													else
-													{
-														if (current_instruction.OperandList[2].Type == OperandType::Register)
-														{
-															if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-															{
-																error = true;
-																error_type = ErrorType::XOCHIPRequired;
-																break;
-															}
-															unsigned char reg2 = 0x0;
-															if (!ProcessRegisterOperand(2, reg2))
-															{
-																error = true;
-																error_type = ErrorType::InvalidRegister;
-																break;
-															}
-															ProgramData.push_back(0x50 | (reg1 & 0xF));
-															ProgramData.push_back((reg2 << 4) | 0x2);
-														}
-													}
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-												}
-											}
-											break;
-										}
-										case OperandType::LoResFont:
-										{
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg = 0x0;
-												if (!ProcessRegisterOperand(1, reg))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0xF0 | (reg & 0xF));
-												ProgramData.push_back(0x29);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-										case OperandType::HiResFont:
-										{
-											if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-											{
-												error = true;
-												error_type = ErrorType::SuperCHIP11Required;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg = 0x0;
-												if (!ProcessRegisterOperand(1, reg))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0xF0 | (reg & 0xF));
-												ProgramData.push_back(0x30);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-										case OperandType::BCD:
-										{
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg = 0x0;
-												if (!ProcessRegisterOperand(1, reg))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0xF0 | (reg & 0xF));
-												ProgramData.push_back(0x33);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-										case OperandType::UserRPL:
-										{
-											if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-											{
-												error = true;
-												error_type = ErrorType::SuperCHIP10Required;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg = 0x0;
-												if (!ProcessRegisterOperand(1, reg))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0xF0 | (reg & 0xF));
-												ProgramData.push_back(0x75);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Add:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											switch (current_instruction.OperandList[1].Type)
-											{
-												case OperandType::Register:
-												{
-													unsigned char reg2 = 0x0;
-													if (!ProcessRegisterOperand(1, reg2))
-													{
-														error = true;
-														error_type = ErrorType::InvalidRegister;
-														break;
-													}
-													ProgramData.push_back(0x80 | (reg1 & 0xF));
-													ProgramData.push_back((reg2 << 4) | 0x4);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-												case OperandType::ImmediateValue:
-												{
-													unsigned char value = Process8BitImmediateValueOperand(1);
-													if (error)
-													{
-														break;
-													}
-													ProgramData.push_back(0x70 | (reg1 & 0xF));
-													ProgramData.push_back(value);
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-														break;
-													}
-													break;
-												}
-											}
-											break;
-										}
-										case OperandType::AddressRegister:
-										{
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg = 0x0;
-												if (!ProcessRegisterOperand(1, reg))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0xF0 | (reg & 0xF));
-												ProgramData.push_back(0x1E);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Or:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0x1);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::And:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0x2);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Xor:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0x3);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Subtract:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0x5);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::ShiftRight:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidValue;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0x6);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::SubtractN:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if(!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0x7);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Plane:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::ImmediateValue:
-										{
-											unsigned char value = Process8BitImmediateValueOperand(0);
-											if (error)
-											{
-												break;
-											}
-											ProgramData.push_back(0xF0 | (value & 0xF));
-											ProgramData.push_back(0x01);
-											current_address += 2;
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Audio:
-								{
-									if (current_instruction.OperandList.size() > 0)
-									{
-										error = true;
-										error_type = ErrorType::NoOperandsSupported;
-										break;
-									}
-									ProgramData.push_back(0xF0);
-									ProgramData.push_back(0x02);
-									current_address += 2;
-									break;
-								}
-								case InstructionType::Pitch:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg = 0x0;
-											if (!ProcessRegisterOperand(0, reg))
-											{
-												break;
-											}
-											ProgramData.push_back(0xF0 | (reg & 0xF));
-											ProgramData.push_back(0x3A);
-											current_address += 2;
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::RotateRight:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0x8);
-												current_address += 2;
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::RotateLeft:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0x9);
-												current_address += 2;
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Test:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidValue;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0xA);
-												current_address += 2;
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Not:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidValue;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0xB);
-												current_address += 2;
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::ShiftLeft:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												ProgramData.push_back(0x80 | (reg1 & 0xF));
-												ProgramData.push_back((reg2 << 4) | 0xE);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Random:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg = 0x0;
-											if (!ProcessRegisterOperand(0, reg))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::ImmediateValue)
-											{
-												unsigned char value = Process8BitImmediateValueOperand(1);
-												if (error)
-												{
-													break;
-												}
-												ProgramData.push_back(0xC0 | (reg & 0xF));
-												ProgramData.push_back(value);
-												current_address += 2;
-												if (current_address > 0xFFF && CurrentExtension != ExtensionType::HyperCHIP64)
-												{
-													error = true;
-													error_type = ErrorType::Only4KBSupported;
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Draw:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg1 = 0x0;
-											if (!ProcessRegisterOperand(0, reg1))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											if (current_instruction.OperandList[1].Type == OperandType::Register)
-											{
-												unsigned char reg2 = 0x0;
-												if (!ProcessRegisterOperand(1, reg2))
-												{
-													error = true;
-													error_type = ErrorType::InvalidRegister;
-													break;
-												}
-												if (current_instruction.OperandList[2].Type == OperandType::ImmediateValue)
-												{
-													unsigned char height = Process8BitImmediateValueOperand(2);
-													if (error)
-													{
-														break;
-													}
-													ProgramData.push_back(0xD0 | (reg1 & 0xF));
-													ProgramData.push_back((reg2 << 4) | (height & 0xF));
-													current_address += 2;
-													if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-													{
-														error = true;
-														error_type = ErrorType::Only4KBSupported;
-													}
-													break;
-												}
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::SkipKeyPressed:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg = 0x0;
-											if (!ProcessRegisterOperand(0, reg))
-											{
-												break;
-											}
-											ProgramData.push_back(0xE0 | (reg & 0xF));
-											ProgramData.push_back(0x9E);
-											current_address += 2;
-											if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-											{
-												error = true;
-												error_type = ErrorType::Only4KBSupported;
-												break;
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::SkipKeyNotPressed:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg = 0x0;
-											if (!ProcessRegisterOperand(0, reg))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											ProgramData.push_back(0xE0 | (reg & 0xF));
-											ProgramData.push_back(0xA1);
-											current_address += 2;
-											if (current_address > 0xFFF && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
-											{
-												error = true;
-												error_type = ErrorType::Only4KBSupported;
-												break;
-											}
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Volume:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::Register:
-										{
-											unsigned char reg = 0x0;
-											if (!ProcessRegisterOperand(0, reg))
-											{
-												error = true;
-												error_type = ErrorType::InvalidRegister;
-												break;
-											}
-											ProgramData.push_back(0xF0 | (reg & 0xF));
-											ProgramData.push_back(0x3B);
-											current_address += 2;
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Voice:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::ImmediateValue:
-										{
-											unsigned char value = Process8BitImmediateValueOperand(0);
-											if (error)
-											{
-												break;
-											}
-											ProgramData.push_back(0xF0 | (value & 0xF));
-											ProgramData.push_back(0x3C);
-											current_address += 2;
-											break;
-										}
-									}
-									break;
-								}
-								case InstructionType::Channel:
-								{
-									if (!OperandCountCheck())
-									{
-										break;
-									}
-									switch (current_instruction.OperandList[0].Type)
-									{
-										case OperandType::None:
-										{
-											error = true;
-											error_type = ErrorType::InvalidValue;
-											break;
-										}
-										case OperandType::ImmediateValue:
-										{
-											unsigned char value = Process8BitImmediateValueOperand(0);
-											if (error)
-											{
-												break;
-											}
-											ProgramData.push_back(0xF0 | (value & 0xF));
-											ProgramData.push_back(0x3D);
-											current_address += 2;
-											break;
-										}
-									}
-									break;
-								}
-							}
-						}
-						break;
-					}
-					default:
-					{
-						if (!comment)
-						{
-							if (token.size() == 0)
-							{
-								switch (token_type)
-								{
-									case TokenType::Instruction:
-									{
-										if (isdigit(static_cast<unsigned char>(line_data[i])))
-										{
-											current_operand.Type = OperandType::ImmediateValue;
-										}
-										else if (isspace(static_cast<unsigned char>(line_data[i])))
-										{
-											break;
-										}
-										token += line_data[i];
-										break;
-									}
-									case TokenType::Origin:
-									{
-										if (isspace(static_cast<unsigned char>(line_data[i])))
-										{
-											break;
-										}
-										token += line_data[i];
-										break;
-									}
-									case TokenType::DataByte:
-									{
-										if (!string_mode)
-										{
-											if (isspace(static_cast<unsigned char>(line_data[i])))
-											{
-												break;
-											}
-											token += line_data[i];
-										}
-										else
-										{
-											ProcessStringDataByte(line_data[i]);
-											if (escape_mode)
-											{
-												escape_mode = false;
-											}
-										}
-										break;
-									}
-									case TokenType::DataWord:
-									{
-										if (!string_mode)
-										{
-											if (isspace(static_cast<unsigned char>(line_data[i])))
-											{
-												break;
-											}
-											token += line_data[i];
-										}
-										break;
-									}
-									default:
-									{
-										if (isdigit(static_cast<unsigned char>(line_data[i])))
-										{
-											error = true;
-											break;
-										}
-										else if (isspace(static_cast<unsigned char>(line_data[i])))
-										{
-											break;
-										}
-										token += line_data[i];
-										break;
-									}
-								}
-							}
-							else
-							{
-								if (!pointer_mode || (current_operand.Type == OperandType::Pointer && pointer_mode))
-								{
-									token += line_data[i];
-								}
-								else
-								{
-									error = true;
-								}
-							}
-						}
-						break;
-					}
+					timing = Args[++i];
 				}
-				if (error)
+			}
+			else if (Args[i] == "--run")
+			{
+				if (i + 1 < Args.size())
 				{
-					++error_count;
-					std::cout << "Error at " << current_line_number << ':' << i - token.size() << " : ";
-					switch (error_type)
+					char *end = nullptr;
+					run_cycles = std::strtoull(Args[++i].c_str(), &end, 0);
+					if (*end != '\0' || run_cycles == 0 || Args[i][0] == '-')
 					{
-						case ErrorType::ReservedToken:
-						{
-							std::cout << "Reserved Token '" << u_token << "'\n";
-							break;
-						}
-						case ErrorType::InvalidToken:
-						{
-							std::cout << "Invalid Token '" << token << "'\n";
-							break;
-						}
-						case ErrorType::NoOperandsSupported:
-						{
-							switch (current_instruction.Type)
-							{
-								case InstructionType::ClearScreen:
-								{
-									std::cout << "CLS";
-									break;
-								}
-								case InstructionType::Return:
-								{
-									std::cout << "RET";
-									break;
-								}
-								case InstructionType::ScrollRight:
-								{
-									std::cout << "SCR";
-									break;
-								}
-								case InstructionType::ScrollLeft:
-								{
-									std::cout << "SCL";
-									break;
-								}
-								case InstructionType::Exit:
-								{
-									std::cout << "EXIT";
-									break;
-								}
-								case InstructionType::Low:
-								{
-									std::cout << "LOW";
-									break;
-								}
-								case InstructionType::High:
-								{
-									std::cout << "HIGH";
-									break;
-								}
-								case InstructionType::Audio:
-								{
-									std::cout << "AUDIO";
-									break;
-								}
-							}
-							std::cout << " does not support operands.\n";
-							break;
-						}
-						case ErrorType::TooFewOperands:
-						{
-							switch (current_instruction.Type)
-							{
-								case InstructionType::ScrollDown:
-								{
-									std::cout << "SCD";
-									break;
-								}
-								case InstructionType::ScrollUp:
-								{
-									std::cout << "SCU";
-									break;
-								}
-								case InstructionType::Jump:
-								{
-									std::cout << "JP";
-									break;
-								}
-								case InstructionType::Call:
-								{
-									std::cout << "CALL";
-									break;
-								}
-								case InstructionType::SkipEqual:
-								{
-									std::cout << "SE";
-									break;
-								}
-								case InstructionType::SkipNotEqual:
-								{
-									std::cout << "SNE";
-									break;
-								}
-								case InstructionType::Load:
-								{
-									std::cout << "LD";
-									break;
-								}
-								case InstructionType::Add:
-								{
-									std::cout << "ADD";
-									break;
-								}
-								case InstructionType::Or:
-								{
-									std::cout << "OR";
-									break;
-								}
-								case InstructionType::And:
-								{
-									std::cout << "AND";
-									break;
-								}
-								case InstructionType::Xor:
-								{
-									std::cout << "XOR";
-									break;
-								}
-								case InstructionType::Subtract:
-								{
-									std::cout << "SUB";
-									break;
-								}
-								case InstructionType::ShiftRight:
-								{
-									std::cout << "SHR";
-									break;
-								}
-								case InstructionType::SubtractN:
-								{
-									std::cout << "SUBN";
-									break;
-								}
-								case InstructionType::Plane:
-								{
-									std::cout << "PLANE";
-									break;
-								}
-								case InstructionType::Pitch:
-								{
-									std::cout << "PITCH";
-									break;
-								}
-								case InstructionType::RotateRight:
-								{
-									std::cout << "ROR";
-									break;
-								}
-								case InstructionType::RotateLeft:
-								{
-									std::cout << "ROL";
-									break;
-								}
-								case InstructionType::Test:
-								{
-									std::cout << "TEST";
-									break;
-								}
-								case InstructionType::Not:
-								{
-									std::cout << "NOT";
-									break;
-								}
-								case InstructionType::ShiftLeft:
-								{
-									std::cout << "SHL";
-									break;
-								}
-								case InstructionType::Random:
-								{
-									std::cout << "RND";
-									break;
-								}
-								case InstructionType::Draw:
-								{
-									std::cout << "DRW";
-									break;
-								}
-								case InstructionType::SkipKeyPressed:
-								{
-									std::cout << "SKP";
-									break;
-								}
-								case InstructionType::SkipKeyNotPressed:
-								{
-									std::cout << "SKNP";
-									break;
-								}
-								case InstructionType::Volume:
-								{
-									std::cout << "VOLUME";
-									break;
-								}
-								case InstructionType::Voice:
-								{
-									std::cout << "VOICE";
-									break;
-								}
-								case InstructionType::Channel:
-								{
-									std::cout << "CHANNEL";
-									break;
-								}
-							}
-							std::cout << " only has " << current_instruction.OperandList.size() << " operands (needs at least " << current_instruction.OperandMinimum << ").\n";
-							break;
-						}
-						case ErrorType::TooManyOperands:
-						{
-							switch (current_instruction.Type)
-							{
-								case InstructionType::ScrollDown:
-								{
-									std::cout << "SCD";
-									break;
-								}
-								case InstructionType::ScrollUp:
-								{
-									std::cout << "SCU";
-									break;
-								}
-								case InstructionType::Jump:
-								{
-									std::cout << "JP";
-									break;
-								}
-								case InstructionType::Call:
-								{
-									std::cout << "CALL";
-									break;
-								}
-								case InstructionType::SkipEqual:
-								{
-									std::cout << "SE";
-									break;
-								}
-								case InstructionType::SkipNotEqual:
-								{
-									std::cout << "SNE";
-									break;
-								}
-								case InstructionType::Load:
-								{
-									std::cout << "LD";
-									break;
-								}
-								case InstructionType::Add:
-								{
-									std::cout << "ADD";
-									break;
-								}
-								case InstructionType::Or:
-								{
-									std::cout << "OR";
-									break;
-								}
-								case InstructionType::And:
-								{
-									std::cout << "AND";
-									break;
-								}
-								case InstructionType::Xor:
-								{
-									std::cout << "XOR";
-									break;
-								}
-								case InstructionType::Subtract:
-								{
-									std::cout << "SUB";
-									break;
-								}
-								case InstructionType::ShiftRight:
-								{
-									std::cout << "SHR";
-									break;
-								}
-								case InstructionType::SubtractN:
-								{
-									std::cout << "SUBN";
-									break;
-								}
-								case InstructionType::Plane:
-								{
-									std::cout << "PLANE";
-									break;
-								}
-								case InstructionType::Pitch:
-								{
-									std::cout << "PITCH";
-									break;
-								}
-								case InstructionType::RotateRight:
-								{
-									std::cout << "ROR";
-									break;
-								}
-								case InstructionType::RotateLeft:
-								{
-									std::cout << "ROL";
-									break;
-								}
-								case InstructionType::Test:
-								{
-									std::cout << "TEST";
-									break;
-								}
-								case InstructionType::Not:
-								{
-									std::cout << "NOT";
-									break;
-								}
-								case InstructionType::ShiftLeft:
-								{
-									std::cout << "SHL";
-									break;
-								}
-								case InstructionType::Random:
-								{
-									std::cout << "RND";
-									break;
-								}
-								case InstructionType::Draw:
-								{
-									std::cout << "DRW";
-									break;
-								}
-								case InstructionType::SkipKeyPressed:
-								{
-									std::cout << "SKP";
-									break;
-								}
-								case InstructionType::SkipKeyNotPressed:
-								{
-									std::cout << "SKNP";
-									break;
-								}
-								case InstructionType::Volume:
-								{
-									std::cout << "VOLUME";
-									break;
-								}
-								case InstructionType::Voice:
-								{
-									std::cout << "VOICE";
-									break;
-								}
-								case InstructionType::Channel:
-								{
-									std::cout << "CHANNEL";
-									break;
-								}
-							}
-							std::cout << " has too many operands (" << current_instruction.OperandList.size() << ", supports up to " << current_instruction.OperandMaximum << ").\n";
-							break;
-						}
-						case ErrorType::InvalidValue:
-						{
-							std::cout << "Invalid Value\n";
-							break;
-						}
-						case ErrorType::InvalidRegister:
-						{
-							std::cout << "Invalid Register\n";
-							break;
-						}
-						case ErrorType::ReservedAddress:
-						{
-							std::cout << "Addresses 0x000-0x1FF are reserved.\n";
-							break;
-						}
-						case ErrorType::BelowCurrentAddress:
-						{
-							std::cout << "Attempting to the set the address below the current address.\n";
-							break;
-						}
-						case ErrorType::Only4KBSupported:
-						{
-							std::cout << "Current extension only supports up to 4KB (maxed at 0xFFF).\n";
-							break;
-						}
-						case ErrorType::SuperCHIP10Required:
-						{
-							switch (current_instruction.Type)
-							{
-								case InstructionType::Exit:
-								{
-									std::cout << "EXIT";
-									break;
-								}
-								case InstructionType::Low:
-								{
-									std::cout << "LOW";
-									break;
-								}
-								case InstructionType::High:
-								{
-									std::cout << "HIGH";
-									break;
-								}
-								case InstructionType::Load:
-								{
-									std::cout << "LD ";
-									if (current_instruction.OperandList.size() == 2)
-									{
-										switch (current_instruction.OperandList[0].Type)
-										{
-											case OperandType::UserRPL:
-											{
-												std::cout << "R, VX";
-												break;
-											}
-											case OperandType::Register:
-											{
-												if (current_instruction.OperandList[1].Type == OperandType::UserRPL)
-												{
-													std::cout << "VX, R";
-												}
-												break;
-											}
-										}
-									}
-									break;
-								}
-							}
-							std::cout << " instruction requires using at least the SuperCHIP V1.0 extension to use.\n";
-							break;
-						}
-						case ErrorType::SuperCHIP11Required:
-						{
-							switch (current_instruction.Type)
-							{
-								case InstructionType::ScrollDown:
-								{
-									std::cout << "SCD";
-									break;
-								}
-								case InstructionType::ScrollRight:
-								{
-									std::cout << "SCR";
-									break;
-								}
-								case InstructionType::ScrollLeft:
-								{
-									std::cout << "SCL";
-									break;
-								}
-								case InstructionType::Load:
-								{
-									std::cout << "LD ";
-									if (current_instruction.OperandList.size() == 2)
-									{
-										if (current_instruction.OperandList[0].Type == OperandType::HiResFont)
-										{
-											std::cout << "HF, VX";
-										}
-									}
-									break;
-								}
-							}
-							std::cout << " instruction requires using at least the SuperCHIP V1.1 extension to use.\n";
-							break;
-						}
-						case ErrorType::XOCHIPRequired:
-						{
-							switch (current_instruction.Type)
-							{
-								case InstructionType::ScrollUp:
-								{
-									std::cout << "SCU";
-									break;
-								}
-								case InstructionType::Load:
-								{
-									if (current_instruction.OperandList.size() >= 2 && current_instruction.OperandList.size() <= 3)
-									{
-										std::cout << "LD ";
-										switch (current_instruction.OperandList[0].Type)
-										{
-											case OperandType::Register:
-											{
-												if (current_instruction.OperandList[1].Type == OperandType::Register)
-												{
-													if (current_instruction.OperandList[2].Type == OperandType::Pointer)
-													{
-														std::cout << "VX, VY, [I]";
-													}
-												}
-												break;
-											}
-											case OperandType::Pointer:
-											{
-												if (current_instruction.OperandList[1].Type == OperandType::Register)
-												{
-													if (current_instruction.OperandList[2].Type == OperandType::Register)
-													{
-														std::cout << "[I], VX, VY";
-													}
-												}
-												break;
-											}
-										}
-									}
-									break;
-								}
-								case InstructionType::Plane:
-								{
-									std::cout << "PLANE";
-									break;
-								}
-								case InstructionType::Audio:
-								{
-									std::cout << "AUDIO";
-									break;
-								}
-								case InstructionType::Pitch:
-								{
-									std::cout << "PITCH";
-									break;
-								}
-							}
-							std::cout << " requires using at least the XO-CHIP extension to use.\n";
-							break;
-						}
-						case ErrorType::HyperCHIP64Required:
-						{
-							switch (current_instruction.Type)
-							{
-								case InstructionType::RotateRight:
-								{
-									std::cout << "ROR";
-									break;
-								}
-								case InstructionType::RotateLeft:
-								{
-									std::cout << "ROL";
-									break;
-								}
-								case InstructionType::Test:
-								{
-									std::cout << "TEST";
-									break;
-								}
-								case InstructionType::Not:
-								{
-									std::cout << "NOT";
-									break;
-								}
-								case InstructionType::Jump:
-								{
-									std::cout << "JP ";
-									if (current_instruction.OperandList.size() == 1)
-									{
-										if (current_instruction.OperandList[0].Type == OperandType::Pointer)
-										{
-											std::cout << "[I + VX]";
-										}
-									}
-									break;
-								}
-								case InstructionType::Call:
-								{
-									std::cout << "CALL ";
-									if (current_instruction.OperandList.size() == 1)
-									{
-										if (current_instruction.OperandList[0].Type == OperandType::Pointer)
-										{
-											std::cout << "[I + VX]";
-										}
-									}
-									break;
-								}
-								case InstructionType::Load:
-								{
-									if (current_instruction.OperandList.size() >= 2 && current_instruction.OperandList.size() <= 3)
-									{
-										std::cout << "LD ";
-										switch (current_instruction.OperandList[0].Type)
-										{
-											case OperandType::AddressRegister:
-											{
-												if (current_instruction.OperandList[1].Type == OperandType::Pointer)
-												{
-													std::cout << "I, [I + VX]";
-												}
-												break;
-											}
-										}
-									}
-									break;
-								}
-								case InstructionType::Volume:
-								{
-									std::cout << "VOLUME";
-									break;
-								}
-								case InstructionType::Voice:
-								{
-									std::cout << "VOICE";
-									break;
-								}
-								case InstructionType::Channel:
-								{
-									std::cout << "CHANNEL";
-									break;
-								}
-							}
-							std::cout << " instruction requires using at least the HyperCHIP-64 extension to use.\n";
-							break;
-						}
-						case ErrorType::BinaryFileDoesNotExist:
-						{
-							std::cout << '\'' << token << "' does not exist.\n";
-							break;
-						}
-						default:
-						{
-							std::cout << "Unknown Error\n";
-							break;
-						}
+						std::cout << "Invalid cycle count '" << Args[i] << "'.\n\n";
+						retcode = -1;
+						return;
 					}
-					break;
 				}
 			}
-			++current_line_number;
-		}
-		for (auto u : UnresolvedReferenceList)
-		{
-			bool resolved = false;
-			for (auto s : SymbolTable)
+			else if (Args[i] == "--watch")
+			{
+				watch = true;
+			}
+			else if (Args[i] == "--server")
 			{
-				if (s.Type == SymbolType::Label)
+				if (i + 1 < Args.size())
 				{
-					if (u.Name == s.Name)
-					{
-						resolved = true;
-						if (u.IsInstruction)
-						{
-							if (u.LongAddress)
-							{
-								ProgramData[u.Address + 2] = (s.Location >> 8);
-								ProgramData[u.Address + 3] = (s.Location & 0xFF);
-							}
-							else
-							{
-								ProgramData[u.Address] |= ((s.Location & 0xF00) >> 8);
-								ProgramData[u.Address + 1] = (s.Location & 0xFF);
-							}
-						}
-						else
-						{
-							ProgramData[u.Address] = (s.Location >> 8);
-							ProgramData[u.Address + 1] = (s.Location & 0xFF);
-						}
-						break;
-					}
+					server_switch = true;
+					SocketPath = Args[++i];
 				}
 			}
-			if (!resolved)
+			else if (InputPath.size() == 0)
 			{
-				++error_count;
-				std::cout << "Unresolved reference '" << u.Name << "' at line " << u.LineNumber << ".\n";
+				InputPath = Args[i];
 			}
 		}
-		if (error_count == 0)
+		if (server_switch)
 		{
-			switch (CurrentOutputType)
+			Server AssemblerServer(SocketPath, Cache);
+			if (!AssemblerServer.Run())
 			{
-				case OutputType::Binary:
-				{
-					output_file.write(reinterpret_cast<char *>(ProgramData.data()), ProgramData.size());
-					break;
-				}
-				case OutputType::HexASCIIString:
-				{
-					std::ostringstream hex_data;
-					hex_data << std::hex;
-					for (size_t c = 0; c < ProgramData.size(); ++c)
-					{
-						hex_data << std::setfill('0') << std::setw(2) << static_cast<unsigned short>(ProgramData[c]);
-					}
-					output_file.write(hex_data.str().c_str(), hex_data.str().size());
-					break;
-				}
+				retcode = -1;
 			}
-			std::cout << "Assembly successful!\n";
+			return;
+		}
+		std::ifstream input_file(InputPath);
+		if (input_file.fail())
+		{
+			std::cout << "Unable to open '" << InputPath << "'.\n\n";
+			retcode = -1;
+			return;
+		}
+		if (!output_switch && object_mode)
+		{
+			size_t extension = InputPath.find_last_of('.');
+			size_t separator = InputPath.find_last_of('/');
+			OutputPath = ((extension != std::string::npos && (separator == std::string::npos || extension > separator)) ? InputPath.substr(0, extension) : InputPath) + ".o";
+			output_switch = true;
+		}
+		if (!output_switch)
+		{
+			std::cout << "You need to specify an output file.\n\n";
+			retcode = -1;
+			return;
+		}
+		if (OutputPath == InputPath || ListingPath == InputPath || GraphPath == InputPath || BlockMapPath == InputPath || DecodeTablePath == InputPath || PageMapPath == InputPath)
+		{
+			std::cout << "Do not specify the output file as the input file.\n\n";
+			retcode = -1;
+			return;
+		}
+		std::ifstream existing_output_file(OutputPath, std::ios::binary);
+		if (!existing_output_file.fail())
+		{
+			LastOutputData.assign(std::istreambuf_iterator<char>(existing_output_file), std::istreambuf_iterator<char>());
+			struct stat file_status;
+			if (stat(OutputPath.c_str(), &file_status) == 0)
+			{
+				last_output_time = file_status.st_mtime;
+			}
+		}
+		std::cout << "Attempting to assemble " << InputPath << " to " << OutputPath << "...\n";
+		AssembleFile();
+		if (watch)
+		{
+			Watch();
 		}
-		std::cout << '\n' << "There " << ((error_count != 1) ? "were " : "was ") << error_count << " error" << ((error_count != 1) ? "s.\n" : ".\n");
 	}
 	else
 	{
-		std::cout << "Format:  bandchip_assembler <input> -o <output>\n\n";
+		std::cout << "Format:  bandchip_assembler <input> -o <output> [-O | -Os | -Ospeed] [--dedup] [--prune] [--profile <profile>] [--list <listing>] [--timing <model>] [--cfg <dot>] [--block-map <map>] [--decode <table>] [--write-map <map>] [--run <cycles>] [--watch]\n";
+		std::cout << "         bandchip_assembler -c <input> [-o <object>] [-O | -Os | -Ospeed] [--dedup] [--list <listing>] [--timing <model>] [--watch]\n";
+		std::cout << "         bandchip_assembler --server <socket>\n";
+		std::cout << "         bandchip_assembler --lsp\n\n";
 	}
 }
 
@@ -4437,3 +222,225 @@ int BandCHIP_Assembler::Application::GetReturnCode() const
 {
 	return retcode;
 }
+
+bool BandCHIP_Assembler::Application::AssembleFile()
+{
+	std::ifstream input_file(InputPath);
+	if (input_file.fail())
+	{
+		std::cout << "Unable to open '" << InputPath << "'.\n\n";
+		return false;
+	}
+	Assembler CurrentAssembler(std::cout, Cache);
+	if (object_mode)
+	{
+		CurrentAssembler.SetOption("OBJECT", "ON");
+	}
+	if (optimization != "OFF")
+	{
+		CurrentAssembler.SetOption("OPTIMIZE", optimization);
+	}
+	if (deduplicate)
+	{
+		CurrentAssembler.SetOption("DEDUPLICATE", "ON");
+	}
+	if (prune)
+	{
+		CurrentAssembler.SetOption("PRUNE", "ON");
+	}
+	if (ProfilePath.size() > 0)
+	{
+		std::ifstream profile_file(ProfilePath);
+		if (profile_file.fail() || !CurrentAssembler.LoadProfile(profile_file))
+		{
+			std::cout << "Unable to read the profile '" << ProfilePath << "'.\n\n";
+			return false;
+		}
+	}
+	if (timing.size() > 0 && !CurrentAssembler.SetOption("TIMING", timing))
+	{
+		std::cout << "Unknown timing model '" << timing << "'.\n\n";
+		return false;
+	}
+	CurrentAssembler.Assemble(input_file);
+	DependencyList = CurrentAssembler.GetDependencyList();
+	if (ProfilePath.size() > 0)
+	{
+		DependencyList.push_back(ProfilePath);
+	}
+	size_t error_count = CurrentAssembler.GetErrorCount();
+	if (error_count == 0)
+	{
+		if (WriteOutput(CurrentAssembler.GetOutputData()))
+		{
+			std::cout << "Assembly successful!\n";
+		}
+		else
+		{
+			++error_count;
+			std::cout << "Unable to write to '" << OutputPath << "'.\n";
+		}
+		auto WriteReport = [&error_count](const std::string &path, const std::string &report)
+		{
+			std::ofstream report_file(path, std::ios::binary);
+			report_file << report;
+			if (report_file.fail())
+			{
+				++error_count;
+				std::cout << "Unable to write to '" << path << "'.\n";
+			}
+		};
+		if (ListingPath.size() > 0)
+		{
+			WriteReport(ListingPath, CurrentAssembler.GetListing());
+		}
+		if (GraphPath.size() > 0)
+		{
+			WriteReport(GraphPath, CurrentAssembler.GetControlFlowGraph());
+		}
+		if (BlockMapPath.size() > 0)
+		{
+			std::vector<unsigned char> BlockMap = WriteBlockMap(CurrentAssembler.GetBasicBlockList());
+			WriteReport(BlockMapPath, std::string(BlockMap.begin(), BlockMap.end()));
+		}
+		if (DecodeTablePath.size() > 0)
+		{
+			std::vector<unsigned char> DecodeTable = WriteDecodeTable(CurrentAssembler.GetProgramData(), CurrentAssembler.GetInstructionLocationList());
+			WriteReport(DecodeTablePath, std::string(DecodeTable.begin(), DecodeTable.end()));
+		}
+		if (PageMapPath.size() > 0)
+		{
+			std::vector<unsigned char> PageMap = WritePageMap(CurrentAssembler.GetWriteRangeList(), CurrentAssembler.GetProgramData().size());
+			WriteReport(PageMapPath, std::string(PageMap.begin(), PageMap.end()));
+		}
+		if (run_cycles > 0 && !object_mode)
+		{
+			std::cout << '\n' << CurrentAssembler.RunProgram(run_cycles);
+		}
+	}
+	std::cout << '\n' << "There " << ((error_count != 1) ? "were " : "was ") << error_count << " error" << ((error_count != 1) ? "s.\n" : ".\n");
+	return error_count == 0;
+}
+
+bool BandCHIP_Assembler::Application::WriteOutput(const std::vector<unsigned char> &output_data)
+{
+	if (output_data == LastOutputData && IsOutputCurrent())
+	{
+		std::cout << "Output is unchanged, leaving '" << OutputPath << "' untouched.\n";
+		return true;
+	}
+	std::ofstream output_file(OutputPath, std::ios::binary);
+	if (output_file.fail())
+	{
+		return false;
+	}
+	output_file.write(reinterpret_cast<const char *>(output_data.data()), output_data.size());
+	output_file.close();
+	if (output_file.fail())
+	{
+		return false;
+	}
+	LastOutputData = output_data;
+	struct stat file_status;
+	last_output_time = (stat(OutputPath.c_str(), &file_status) == 0) ? file_status.st_mtime : 0;
+	return true;
+}
+
+bool BandCHIP_Assembler::Application::IsOutputCurrent() const
+{
+	struct stat file_status;
+	return stat(OutputPath.c_str(), &file_status) == 0 && file_status.st_mtime == last_output_time && static_cast<size_t>(file_status.st_size) == LastOutputData.size();
+}
+
+void BandCHIP_Assembler::Application::Watch()
+{
+#ifdef __linux__
+	int inotify_fd = inotify_init1(IN_CLOEXEC);
+	if (inotify_fd < 0)
+	{
+		std::cout << "Unable to initialize file watching.\n\n";
+		retcode = -1;
+		return;
+	}
+	auto SplitPath = [](const std::string &path)
+	{
+		size_t separator = path.find_last_of('/');
+		if (separator == std::string::npos)
+		{
+			return std::make_pair(std::string("."), path);
+		}
+		return std::make_pair((separator == 0) ? std::string("/") : path.substr(0, separator), path.substr(separator + 1));
+	};
+	std::map<std::string, int> DirectoryWatchList;
+	std::cout << "Watching for changes (press Ctrl+C to stop)...\n\n";
+	while (true)
+	{
+		std::vector<std::string> WatchedFileList = DependencyList;
+		WatchedFileList.insert(WatchedFileList.begin(), InputPath);
+		for (auto &f : WatchedFileList)
+		{
+			std::string directory = SplitPath(f).first;
+			if (DirectoryWatchList.find(directory) == DirectoryWatchList.end())
+			{
+				int watch_descriptor = inotify_add_watch(inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+				if (watch_descriptor < 0)
+				{
+					std::cout << "Unable to watch '" << directory << "'.\n";
+					continue;
+				}
+				DirectoryWatchList[directory] = watch_descriptor;
+			}
+		}
+		std::string changed_file = "";
+		while (changed_file.size() == 0)
+		{
+			alignas(struct inotify_event) char event_buffer[4096];
+			ssize_t length = read(inotify_fd, event_buffer, sizeof(event_buffer));
+			if (length <= 0)
+			{
+				if (length < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				std::cout << "File watching stopped unexpectedly.\n\n";
+				close(inotify_fd);
+				retcode = -1;
+				return;
+			}
+			for (char *e = event_buffer; e < event_buffer + length; e += sizeof(struct inotify_event) + reinterpret_cast<struct inotify_event *>(e)->len)
+			{
+				struct inotify_event *event = reinterpret_cast<struct inotify_event *>(e);
+				if (event->len == 0)
+				{
+					continue;
+				}
+				for (auto &f : WatchedFileList)
+				{
+					std::pair<std::string, std::string> file_path = SplitPath(f);
+					auto directory = DirectoryWatchList.find(file_path.first);
+					if (directory != DirectoryWatchList.end() && directory->second == event->wd && file_path.second == event->name)
+					{
+						changed_file = f;
+						break;
+					}
+				}
+			}
+		}
+		// Editors often save through several events in a row, so let them settle before reassembling once.
+		struct pollfd poll_data = { inotify_fd, POLLIN, 0 };
+		while (poll(&poll_data, 1, 50) > 0)
+		{
+			alignas(struct inotify_event) char event_buffer[4096];
+			if (read(inotify_fd, event_buffer, sizeof(event_buffer)) <= 0)
+			{
+				break;
+			}
+		}
+		std::cout << '\'' << changed_file << "' changed, reassembling " << InputPath << " to " << OutputPath << "...\n";
+		AssembleFile();
+	}
+#else
+	std::cout << "Watch mode is only supported on Linux.\n\n";
+	retcode = -1;
+#endif
+}
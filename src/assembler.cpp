@@ -0,0 +1,8721 @@
+#include "../include/assembler.h"
+#include "../include/object.h"
+#include "../include/interpreter.h"
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <regex>
+#include <algorithm>
+#include <sys/stat.h>
+
+const std::array<std::string, 54> BandCHIP_Assembler::Assembler::TokenList = {
+	"OUTPUT", "EXTENSION", "ALIGN", "ORG", "INCBIN", "DB", "DW",
+	"CLS", "RET", "JP", "CALL", "SE", "SNE", "LD", "ADD", "OR",
+	"AND", "XOR", "SUB", "SHR", "SUBN", "SHL", "RND", "DRW", "SKP",
+	"SKNP", "SCD", "SCR", "SCL", "EXIT", "LOW", "HIGH", "SCU",
+	"PLANE", "AUDIO", "PITCH", "ROR", "ROL", "TEST", "NOT", "VOLUME",
+	"VOICE", "CHANNEL", "LONG", "MUL", "DIV", "ADD16", "MEMCPY",
+	"MEMSET", "SWITCH", "ASSERT_CYCLES", "RELOCATABLE", "INIT_BEGIN", "INIT_END"
+};
+
+const std::array<std::string, 2> BandCHIP_Assembler::Assembler::OutputTypeList = {
+	"BINARY", "HEXASCIISTRING"
+};
+
+const std::array<std::string, 5> BandCHIP_Assembler::Assembler::ExtensionList = {
+	"CHIP8", "SCHIP10", "SCHIP11", "XOCHIP", "HCHIP64"
+};
+
+const std::array<std::string, 2> BandCHIP_Assembler::Assembler::ToggleList = {
+	"OFF", "ON"
+};
+
+const std::array<std::string, 4> BandCHIP_Assembler::Assembler::OptimizationList = {
+	"OFF", "ON", "SIZE", "SPEED"
+};
+
+const std::array<std::string, 4> BandCHIP_Assembler::Assembler::TimingList = {
+	"AUTO", "VIP", "SCHIP", "XOCHIP"
+};
+
+const std::array<std::string, 16> BandCHIP_Assembler::Assembler::RegisterList = {
+	"V0", "V1", "V2", "V3", "V4", "V5", "V6", "V7",
+	"V8", "V9", "VA", "VB", "VC", "VD", "VE", "VF"
+};
+
+static bool IsSkipOpcode(unsigned short opcode)
+{
+	switch (opcode & 0xF000)
+	{
+		case 0x3000:
+		case 0x4000:
+		{
+			return true;
+		}
+		case 0x5000:
+		case 0x9000:
+		{
+			return (opcode & 0xF) == 0x0;
+		}
+		case 0xE000:
+		{
+			return (opcode & 0xFF) == 0x9E || (opcode & 0xFF) == 0xA1;
+		}
+	}
+	return false;
+}
+
+static bool EndsBasicBlock(unsigned short opcode)
+{
+	switch (opcode & 0xF000)
+	{
+		case 0x0000:
+		{
+			return opcode == 0x00EE || opcode == 0x00FD;
+		}
+		case 0x1000:
+		case 0x2000:
+		case 0xB000:
+		{
+			return true;
+		}
+		case 0xF000:
+		{
+			return (opcode & 0xFF) == 0x20 || (opcode & 0xFF) == 0x21;
+		}
+	}
+	return IsSkipOpcode(opcode);
+}
+
+static bool PreservesAddressRegister(unsigned short opcode)
+{
+	switch (opcode & 0xF000)
+	{
+		case 0x0000:
+		case 0x3000:
+		case 0x4000:
+		case 0x5000:
+		case 0x6000:
+		case 0x7000:
+		case 0x8000:
+		case 0x9000:
+		case 0xC000:
+		case 0xD000:
+		case 0xE000:
+		{
+			return true;
+		}
+		case 0xF000:
+		{
+			switch (opcode & 0xFF)
+			{
+				case 0x01:
+				case 0x02:
+				case 0x07:
+				case 0x0A:
+				case 0x15:
+				case 0x18:
+				case 0x33:
+				case 0x3A:
+				case 0x3B:
+				case 0x3C:
+				case 0x3D:
+				case 0x75:
+				case 0x85:
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	}
+	return false;
+}
+
+static bool OverwritesFlag(unsigned short opcode)
+{
+	size_t x = (opcode >> 8) & 0xF;
+	size_t y = (opcode >> 4) & 0xF;
+	switch (opcode & 0xF000)
+	{
+		case 0x6000:
+		case 0xC000:
+		{
+			return x == 0xF;
+		}
+		case 0x8000:
+		{
+			switch (opcode & 0xF)
+			{
+				case 0x4:
+				case 0x5:
+				case 0x6:
+				case 0x7:
+				case 0xE:
+				{
+					return x != 0xF && y != 0xF;
+				}
+			}
+			return false;
+		}
+		case 0xD000:
+		{
+			return x != 0xF && y != 0xF;
+		}
+	}
+	return false;
+}
+
+static bool IgnoresFlag(unsigned short opcode)
+{
+	size_t x = (opcode >> 8) & 0xF;
+	size_t y = (opcode >> 4) & 0xF;
+	switch (opcode & 0xF000)
+	{
+		case 0x6000:
+		case 0x7000:
+		{
+			return x != 0xF;
+		}
+		case 0x8000:
+		{
+			return (opcode & 0xF) <= 0x3 && x != 0xF && y != 0xF;
+		}
+		case 0xA000:
+		{
+			return true;
+		}
+	}
+	return opcode == 0xF000;
+}
+
+static bool GetCycleCost(BandCHIP_Assembler::TimingType timing, unsigned short opcode, size_t &minimum, size_t &maximum)
+{
+	minimum = maximum = 1;
+	if ((opcode & 0xF0FF) == 0xF00A)
+	{
+		return false;
+	}
+	if (timing != BandCHIP_Assembler::TimingType::VIP)
+	{
+		return true;
+	}
+	size_t x = (opcode >> 8) & 0xF;
+	size_t n = opcode & 0xF;
+	minimum = maximum = 10;
+	switch (opcode & 0xF000)
+	{
+		case 0x0000:
+		{
+			if (opcode == 0x00E0)
+			{
+				minimum = maximum = 3078;
+			}
+			break;
+		}
+		case 0x1000:
+		case 0xA000:
+		{
+			minimum = maximum = 12;
+			break;
+		}
+		case 0x2000:
+		{
+			minimum = maximum = 26;
+			break;
+		}
+		case 0x3000:
+		case 0x4000:
+		{
+			maximum = 14;
+			break;
+		}
+		case 0x5000:
+		case 0x9000:
+		case 0xE000:
+		{
+			if (IsSkipOpcode(opcode))
+			{
+				minimum = 14;
+				maximum = 18;
+			}
+			break;
+		}
+		case 0x6000:
+		{
+			minimum = maximum = 6;
+			break;
+		}
+		case 0x8000:
+		{
+			minimum = maximum = 44;
+			break;
+		}
+		case 0xB000:
+		{
+			minimum = 22;
+			maximum = 24;
+			break;
+		}
+		case 0xC000:
+		{
+			minimum = maximum = 36;
+			break;
+		}
+		case 0xD000:
+		{
+			minimum = 26 + ((n != 0) ? n : 16) * 46;
+			maximum = minimum + 3668;
+			break;
+		}
+		case 0xF000:
+		{
+			switch (opcode & 0xFF)
+			{
+				case 0x1E:
+				{
+					minimum = 16;
+					maximum = 18;
+					break;
+				}
+				case 0x29:
+				{
+					minimum = maximum = 16;
+					break;
+				}
+				case 0x33:
+				{
+					minimum = 84;
+					maximum = 152;
+					break;
+				}
+				case 0x55:
+				case 0x65:
+				{
+					minimum = maximum = 14 + 14 * (x + 1);
+					break;
+				}
+			}
+			break;
+		}
+	}
+	return true;
+}
+
+static void TrackRegisters(unsigned short opcode, std::array<int, 16> &RegisterValueList)
+{
+	size_t x = (opcode >> 8) & 0xF;
+	size_t y = (opcode >> 4) & 0xF;
+	int vx = RegisterValueList[x];
+	int vy = RegisterValueList[y];
+	bool known = (vx >= 0 && vy >= 0);
+	switch (opcode & 0xF000)
+	{
+		case 0x5000:
+		{
+			if ((opcode & 0xF) == 0x3)
+			{
+				for (size_t r = std::min(x, y); r <= std::max(x, y); ++r)
+				{
+					RegisterValueList[r] = -1;
+				}
+			}
+			return;
+		}
+		case 0x6000:
+		{
+			RegisterValueList[x] = opcode & 0xFF;
+			return;
+		}
+		case 0x7000:
+		{
+			RegisterValueList[x] = (vx >= 0) ? ((vx + (opcode & 0xFF)) & 0xFF) : -1;
+			return;
+		}
+		case 0x8000:
+		{
+			int result = -1;
+			int flag = -1;
+			switch (opcode & 0xF)
+			{
+				case 0x0:
+				{
+					RegisterValueList[x] = vy;
+					return;
+				}
+				case 0x1:
+				{
+					result = known ? (vx | vy) : -1;
+					break;
+				}
+				case 0x2:
+				{
+					result = known ? (vx & vy) : -1;
+					break;
+				}
+				case 0x3:
+				{
+					result = known ? (vx ^ vy) : -1;
+					break;
+				}
+				case 0x4:
+				{
+					result = known ? ((vx + vy) & 0xFF) : -1;
+					flag = known ? ((vx + vy > 0xFF) ? 1 : 0) : -1;
+					break;
+				}
+				case 0x5:
+				{
+					result = known ? ((vx - vy) & 0xFF) : -1;
+					flag = known ? ((vx >= vy) ? 1 : 0) : -1;
+					break;
+				}
+				case 0x7:
+				{
+					result = known ? ((vy - vx) & 0xFF) : -1;
+					flag = known ? ((vy >= vx) ? 1 : 0) : -1;
+					break;
+				}
+				case 0xA:
+				{
+					RegisterValueList[0xF] = known ? (((vx & vy) != 0) ? 1 : 0) : -1;
+					return;
+				}
+				case 0xB:
+				{
+					RegisterValueList[x] = (vy >= 0) ? (~vy & 0xFF) : -1;
+					return;
+				}
+			}
+			RegisterValueList[x] = result;
+			RegisterValueList[0xF] = (x != 0xF) ? flag : -1;
+			return;
+		}
+		case 0xC000:
+		{
+			RegisterValueList[x] = -1;
+			return;
+		}
+		case 0xD000:
+		{
+			RegisterValueList[0xF] = -1;
+			return;
+		}
+		case 0xF000:
+		{
+			switch (opcode & 0xFF)
+			{
+				case 0x07:
+				case 0x0A:
+				{
+					RegisterValueList[x] = -1;
+					return;
+				}
+				case 0x65:
+				case 0x85:
+				{
+					std::fill(RegisterValueList.begin(), RegisterValueList.begin() + x + 1, -1);
+					return;
+				}
+				case 0x01:
+				case 0x02:
+				case 0x15:
+				case 0x18:
+				case 0x1E:
+				case 0x20:
+				case 0x21:
+				case 0x29:
+				case 0x30:
+				case 0x33:
+				case 0x3A:
+				case 0x3B:
+				case 0x3C:
+				case 0x3D:
+				case 0x55:
+				case 0x75:
+				case 0xA2:
+				{
+					return;
+				}
+			}
+			RegisterValueList.fill(-1);
+			return;
+		}
+	}
+}
+
+static std::vector<unsigned short> GetMultiplyList(unsigned char reg, unsigned char scratch, unsigned char value)
+{
+	std::vector<unsigned short> OpcodeList;
+	if (value == 0)
+	{
+		OpcodeList.push_back(0x6000 | (reg << 8));
+		return OpcodeList;
+	}
+	std::vector<int> BinaryDigitList;
+	std::vector<int> SignedDigitList;
+	for (int v = value; v != 0; v >>= 1)
+	{
+		BinaryDigitList.push_back(v & 1);
+	}
+	for (int v = value; v != 0; v >>= 1)
+	{
+		int digit = 0;
+		if (v & 1)
+		{
+			digit = 2 - (v & 3);
+			v -= digit;
+		}
+		SignedDigitList.push_back(digit);
+	}
+	auto GetCost = [](const std::vector<int> &DigitList)
+	{
+		size_t cost = DigitList.size() - 1;
+		for (size_t d = 0; d + 1 < DigitList.size(); ++d)
+		{
+			cost += (DigitList[d] != 0) ? 1 : 0;
+		}
+		return cost;
+	};
+	const std::vector<int> &DigitList = (GetCost(SignedDigitList) < GetCost(BinaryDigitList)) ? SignedDigitList : BinaryDigitList;
+	if ((value & (value - 1)) != 0)
+	{
+		OpcodeList.push_back(0x8000 | (scratch << 8) | (reg << 4));
+	}
+	for (size_t d = DigitList.size() - 1; d > 0; --d)
+	{
+		OpcodeList.push_back(0x8004 | (reg << 8) | (reg << 4));
+		if (DigitList[d - 1] > 0)
+		{
+			OpcodeList.push_back(0x8004 | (reg << 8) | (scratch << 4));
+		}
+		else if (DigitList[d - 1] < 0)
+		{
+			OpcodeList.push_back(0x8005 | (reg << 8) | (scratch << 4));
+		}
+	}
+	return OpcodeList;
+}
+
+static std::vector<unsigned short> GetDivideList(unsigned char reg, unsigned char scratch, unsigned char value)
+{
+	std::vector<unsigned short> OpcodeList;
+	if ((value & (value - 1)) == 0)
+	{
+		for (unsigned char v = value; v > 1; v >>= 1)
+		{
+			OpcodeList.push_back(0x8006 | (reg << 8) | (reg << 4));
+		}
+		return OpcodeList;
+	}
+	int shift = 0;
+	while ((value << (shift + 1)) <= 0xFF)
+	{
+		++shift;
+	}
+	OpcodeList.push_back(0x6000 | (scratch << 8));
+	for (int s = shift; s >= 0; --s)
+	{
+		unsigned char step = value << s;
+		OpcodeList.push_back(0x6F00 | step);
+		OpcodeList.push_back(0x80F5 | (reg << 8));
+		if (s > 0)
+		{
+			OpcodeList.push_back(0x3F01);
+			OpcodeList.push_back(0x7000 | (reg << 8) | step);
+		}
+		OpcodeList.push_back(0x3F00);
+		OpcodeList.push_back(0x7000 | (scratch << 8) | (1 << s));
+	}
+	OpcodeList.push_back(0x8000 | (reg << 8) | (scratch << 4));
+	return OpcodeList;
+}
+
+std::shared_ptr<const std::vector<unsigned char>> BandCHIP_Assembler::BinaryFileCache::Load(const std::string &path)
+{
+	struct stat file_status;
+	if (stat(path.c_str(), &file_status) != 0)
+	{
+		return nullptr;
+	}
+	{
+		std::lock_guard<std::mutex> lock(FileListMutex);
+		auto cached_file = FileList.find(path);
+		if (cached_file != FileList.end())
+		{
+			if (cached_file->second.ModifiedTime == file_status.st_mtime && cached_file->second.Size == static_cast<size_t>(file_status.st_size))
+			{
+				return cached_file->second.Data;
+			}
+		}
+	}
+	std::ifstream binary_file(path, std::ios::binary);
+	if (binary_file.fail())
+	{
+		return nullptr;
+	}
+	binary_file.seekg(0, std::ios::end);
+	size_t file_size = binary_file.tellg();
+	binary_file.seekg(0, std::ios::beg);
+	std::shared_ptr<std::vector<unsigned char>> binary_data = std::make_shared<std::vector<unsigned char>>(file_size);
+	binary_file.read(reinterpret_cast<char *>(binary_data->data()), file_size);
+	std::lock_guard<std::mutex> lock(FileListMutex);
+	FileList[path] = { file_status.st_mtime, file_size, binary_data };
+	return binary_data;
+}
+
+BandCHIP_Assembler::Assembler::Assembler(std::ostream &log, BinaryFileCache &cache) : current_line_number(1), current_address(0x200), error_count(0), Log(log), Cache(cache), CurrentOutputType(BandCHIP_Assembler::OutputType::Binary), CurrentExtension(BandCHIP_Assembler::ExtensionType::CHIP8), CurrentOptimization(BandCHIP_Assembler::OptimizationType::None), CurrentTiming(BandCHIP_Assembler::TimingType::Automatic), align(true), object_mode(false), origin_used(false), relocatable(false), init_region(false), deduplicate(false), prune(false)
+{
+}
+
+BandCHIP_Assembler::Assembler::~Assembler()
+{
+}
+
+void BandCHIP_Assembler::Assembler::Reset()
+{
+	current_line_number = 1;
+	current_address = 0x200;
+	error_count = 0;
+	CurrentOutputType = OutputType::Binary;
+	CurrentExtension = ExtensionType::CHIP8;
+	align = true;
+	object_mode = false;
+	origin_used = false;
+	relocatable = false;
+	init_region = false;
+	CurrentOptimization = OptimizationType::None;
+	CurrentTiming = TimingType::Automatic;
+	deduplicate = false;
+	prune = false;
+	SymbolTable.clear();
+	SymbolIndex.clear();
+	ProfileIndex.clear();
+	UnresolvedReferenceList.clear();
+	LabelReferenceList.clear();
+	RelaxableReferenceList.clear();
+	OriginList.clear();
+	RelocatableList.clear();
+	InitList.clear();
+	InstructionLocationList.clear();
+	CycleAssertionList.clear();
+	DiagnosticList.clear();
+	ProgramData.clear();
+	DependencyList.clear();
+	SourceLineList.clear();
+}
+
+bool BandCHIP_Assembler::Assembler::SetOption(const std::string &option, const std::string &value)
+{
+	std::string u_option = "";
+	std::string u_value = "";
+	for (size_t c = 0; c < option.size(); ++c)
+	{
+		u_option += toupper(static_cast<unsigned char>(option[c]));
+	}
+	for (size_t c = 0; c < value.size(); ++c)
+	{
+		u_value += toupper(static_cast<unsigned char>(value[c]));
+	}
+	if (u_option == "OUTPUT")
+	{
+		for (size_t o = 0; o < OutputTypeList.size(); ++o)
+		{
+			if (u_value == OutputTypeList[o])
+			{
+				CurrentOutputType = static_cast<OutputType>(o);
+				return true;
+			}
+		}
+	}
+	else if (u_option == "EXTENSION")
+	{
+		for (size_t e = 0; e < ExtensionList.size(); ++e)
+		{
+			if (u_value == ExtensionList[e])
+			{
+				CurrentExtension = static_cast<ExtensionType>(e);
+				return true;
+			}
+		}
+	}
+	else if (u_option == "ALIGN")
+	{
+		for (size_t a = 0; a < ToggleList.size(); ++a)
+		{
+			if (u_value == ToggleList[a])
+			{
+				align = (a != 0);
+				return true;
+			}
+		}
+	}
+	else if (u_option == "OPTIMIZE")
+	{
+		for (size_t o = 0; o < OptimizationList.size(); ++o)
+		{
+			if (u_value == OptimizationList[o])
+			{
+				CurrentOptimization = static_cast<OptimizationType>(o);
+				return true;
+			}
+		}
+	}
+	else if (u_option == "TIMING")
+	{
+		for (size_t t = 0; t < TimingList.size(); ++t)
+		{
+			if (u_value == TimingList[t])
+			{
+				CurrentTiming = static_cast<TimingType>(t);
+				return true;
+			}
+		}
+	}
+	else if (u_option == "DEDUPLICATE")
+	{
+		for (size_t d = 0; d < ToggleList.size(); ++d)
+		{
+			if (u_value == ToggleList[d])
+			{
+				deduplicate = (d != 0);
+				return true;
+			}
+		}
+	}
+	else if (u_option == "PRUNE")
+	{
+		for (size_t p = 0; p < ToggleList.size(); ++p)
+		{
+			if (u_value == ToggleList[p])
+			{
+				prune = (p != 0);
+				return true;
+			}
+		}
+	}
+	else if (u_option == "OBJECT")
+	{
+		for (size_t o = 0; o < ToggleList.size(); ++o)
+		{
+			if (u_value == ToggleList[o])
+			{
+				object_mode = (o != 0);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool BandCHIP_Assembler::Assembler::LoadProfile(std::istream &profile_file)
+{
+	std::string line;
+	while (std::getline(profile_file, line))
+	{
+		size_t comment = line.find_first_of(";#");
+		std::istringstream profile_line(line.substr(0, comment));
+		std::string name;
+		unsigned long count = 0;
+		if (!(profile_line >> name))
+		{
+			continue;
+		}
+		if (!(profile_line >> count))
+		{
+			return false;
+		}
+		ProfileIndex[name] += count;
+	}
+	return true;
+}
+
+bool BandCHIP_Assembler::Assembler::Assemble(std::istream &input_file)
+{
+	while (!input_file.fail())
+	{
+		std::array<char, 4096> line_data;
+		std::string token = "";
+		std::string u_token = "";
+		input_file.getline(line_data.data(), line_data.size(), '\n');
+		size_t characters_read = input_file.gcount();
+		if (input_file.eof() && !input_file.fail() && characters_read > 0)
+		{
+			++characters_read;
+		}
+		SourceLineList.push_back(line_data.data());
+		if (SourceLineList.back().size() > 0 && SourceLineList.back().back() == '\r')
+		{
+			SourceLineList.back().pop_back();
+		}
+		bool error = false;
+		bool comment = false;
+		bool string_mode = false;
+		bool escape_mode = false;
+		bool pointer_mode = false;
+		bool long_mode = false;
+		ErrorType error_type = ErrorType::NoError;
+		TokenType token_type = TokenType::None;
+		OperandData current_operand = { OperandType::None, "" };
+		InstructionData current_instruction = { InstructionType::None, {}, 0, 0 };
+		auto OperandCountCheck = [&error, &error_type, &current_instruction]()
+		{
+			if (current_instruction.OperandList.size() > current_instruction.OperandMaximum)
+			{
+				error = true;
+				error_type = ErrorType::TooManyOperands;
+				return false;
+			}
+			else if (current_instruction.OperandList.size() < current_instruction.OperandMinimum)
+			{
+				error = true;
+				error_type = ErrorType::TooFewOperands;
+				return false;
+			}
+			return true;
+		};
+		auto ProcessLabelOperand = [this, &error, &error_type, &long_mode, &current_instruction](unsigned char operand, unsigned char opcode)
+		{
+			bool long_address_supported = ((CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64) && opcode == 0xA);
+			auto symbol = SymbolIndex.find(current_instruction.OperandList[operand].Data);
+			bool label_found = (symbol != SymbolIndex.end());
+			if (label_found)
+			{
+				const Symbol &s = SymbolTable[symbol->second];
+				if (s.Location > 0xFFF && !long_address_supported && CurrentOptimization != OptimizationType::Size)
+				{
+					error = true;
+					error_type = ErrorType::Only4KBSupported;
+					return;
+				}
+				bool long_address = (s.Location > 0xFFF && long_address_supported);
+				if (long_address_supported && !long_address)
+				{
+					RelaxableReferenceList.push_back(LabelReferenceList.size());
+				}
+				LabelReferenceList.push_back({ s.Name, current_line_number, static_cast<unsigned short>(current_address - 0x200), true, long_address });
+				if (long_address)
+				{
+					ProgramData.push_back(0xF0);
+					ProgramData.push_back(0x00);
+					ProgramData.push_back(s.Location >> 8);
+					ProgramData.push_back(s.Location & 0xFF);
+					current_address += 4;
+					return;
+				}
+				ProgramData.push_back(((opcode & 0xF) << 4) | ((s.Location & 0xF00) >> 8));
+				ProgramData.push_back(s.Location & 0xFF);
+				current_address += 2;
+				if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+				{
+					error = true;
+					error_type = ErrorType::Only4KBSupported;
+					return;
+				}
+			}
+			if (!label_found)
+			{
+				if (long_address_supported && !long_mode)
+				{
+					RelaxableReferenceList.push_back(LabelReferenceList.size());
+				}
+				UnresolvedReferenceList.push_back({ std::move(current_instruction.OperandList[operand].Data), current_line_number, static_cast<unsigned short>(current_address - 0x200), true, long_address_supported && long_mode });
+				LabelReferenceList.push_back(UnresolvedReferenceList.back());
+				if (long_address_supported && long_mode)
+				{
+					ProgramData.push_back(0xF0);
+					ProgramData.push_back(0x00);
+					ProgramData.push_back(0x00);
+					ProgramData.push_back(0x00);
+					current_address += 4;
+					return;
+				}
+				ProgramData.push_back((opcode & 0xF) << 4);
+				ProgramData.push_back(0x00);
+				current_address += 2;
+				if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+				{
+					error = true;
+					error_type = ErrorType::Only4KBSupported;
+					return;
+				}
+			}
+		};
+		auto ProcessAddressImmediateValueOperand = [this, &error, &error_type, &long_mode, &current_instruction](unsigned char operand, unsigned char opcode)
+		{
+			static const std::regex hex("0x[a-fA-F0-9]{1,}");
+			static const std::regex dec("[0-9]{1,}");
+			std::smatch match;
+			unsigned short address = 0;
+			if (std::regex_search(current_instruction.OperandList[operand].Data, match, hex))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return;
+				}
+				std::istringstream hex_str(match.str());
+				hex_str >> std::hex >> address;
+			}
+			else if (std::regex_search(current_instruction.OperandList[operand].Data, match, dec))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return;
+				}
+				std::istringstream dec_str(match.str());
+				dec_str >> address;
+			}
+			if (address > 0xFFF)
+			{
+				if ((CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64) && opcode == 0xA)
+				{
+					if (long_mode)
+					{
+						ProgramData.push_back(0xF0);
+						ProgramData.push_back(0x00);
+						ProgramData.push_back(address >> 8);
+						ProgramData.push_back(address & 0xFF);
+						current_address += 4;
+					}
+				}
+				else
+				{
+					error = true;
+					error_type = ErrorType::Only4KBSupported;
+				}
+			}
+			else
+			{
+				ProgramData.push_back(((opcode & 0xF) << 4) | ((address & 0xF00) >> 8));
+				ProgramData.push_back(address & 0xFF);
+				current_address += 2;
+				if (current_address > 0xFFF && CurrentExtension != ExtensionType::HyperCHIP64 && (CurrentExtension == ExtensionType::XOCHIP || CurrentOptimization != OptimizationType::Size))
+				{
+					error = true;
+					error_type = ErrorType::Only4KBSupported;
+					return;
+				}
+			}
+		};
+		auto Process8BitImmediateValueOperand = [this, &error, &error_type, &current_instruction](unsigned char operand)
+		{
+			static const std::regex hex("0x[a-fA-F0-9]{1,}");
+			static const std::regex dec("[0-9]{1,}");
+			std::smatch match;
+			unsigned short value = 0;
+			if (std::regex_search(current_instruction.OperandList[operand].Data, match, hex))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return static_cast<unsigned char>(0x00);
+				}
+				std::istringstream hex_str(match.str());
+				hex_str >> std::hex >> value;
+			}
+			else if (std::regex_search(current_instruction.OperandList[operand].Data, match, dec))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return static_cast<unsigned char>(0x00);
+				}
+				std::istringstream dec_str(match.str());
+				dec_str >> value;
+			}
+			return static_cast<unsigned char>(value & 0xFF);
+		};
+		auto Process16BitImmediateValueOperand = [this, &error, &error_type, &current_instruction](unsigned char operand)
+		{
+			static const std::regex hex("0x[a-fA-F0-9]{1,}");
+			static const std::regex dec("[0-9]{1,}");
+			std::smatch match;
+			unsigned short value = 0;
+			if (std::regex_search(current_instruction.OperandList[operand].Data, match, hex))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return static_cast<unsigned short>(0x0000);
+				}
+				std::istringstream hex_str(match.str());
+				hex_str >> std::hex >> value;
+			}
+			else if (std::regex_search(current_instruction.OperandList[operand].Data, match, dec))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return static_cast<unsigned short>(0x0000);
+				}
+				std::istringstream dec_str(match.str());
+				dec_str >> value;
+			}
+			return value;
+		};
+		auto ProcessRegisterOperand = [this, &current_instruction](unsigned char operand, unsigned char &reg)
+		{
+			for (auto r : RegisterList)
+			{
+				if (r == current_instruction.OperandList[operand].Data)
+				{
+					return true;
+				}
+				if (reg < 0xF)
+				{
+					++reg;
+				}
+			}
+			return false;
+		};
+		auto ProcessAddressRegisterOffsetPointerOperand = [this, &current_instruction](unsigned char operand, unsigned char &reg)
+		{
+			std::string uptr_data = "";
+			for (size_t c = 0; c < current_instruction.OperandList[operand].Data.size(); ++c)
+			{
+				uptr_data += toupper(static_cast<unsigned char>(current_instruction.OperandList[operand].Data[c]));
+			}
+			for (auto r : RegisterList)
+			{
+				std::string ptr_reg_offstr = "I+" + r;
+				if (uptr_data == ptr_reg_offstr)
+				{
+					return true;
+				}
+				if (reg < 0xF)
+				{
+					++reg;
+				}
+			}
+			return false;
+		};
+		auto ProcessOrigin = [&token, &error, &error_type]()
+		{
+			static const std::regex hex("0x[a-fA-F0-8]{1,}");
+			static const std::regex dec("[0-9]{1,}");
+			std::smatch match;
+			unsigned short address = 0;
+			if (std::regex_search(token, match, hex))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return static_cast<unsigned short>(0);
+				}
+				std::istringstream hex_str(match.str());
+				hex_str >> std::hex >> address;
+			}
+			else if (std::regex_search(token, match, dec))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return static_cast<unsigned short>(0);
+				}
+				std::istringstream dec_str(match.str());
+				dec_str >> address;
+			}
+			return address;
+		};
+		auto ProcessDataByte = [&token, &error, &error_type]()
+		{
+			static const std::regex hex("0x[a-fA-F0-9]{1,}");
+			static const std::regex bin("0b[0-1]{1,8}");
+			static const std::regex dec("[0-9]{1,}");
+			std::smatch match;
+			unsigned short value = 0;
+			if (std::regex_search(token, match, hex))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return static_cast<unsigned char>(0);
+				}
+				std::istringstream hex_str(match.str());
+				hex_str >> std::hex >> value;
+			}
+			else if (std::regex_search(token, match, bin))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return static_cast<unsigned char>(0);
+				}
+				for (size_t c = 0; c < match.str().size() - 2; ++c)
+				{
+					if (match.str()[2 + c] == '1')
+					{
+						value |= (0x80 >> (7 - ((match.str().size() - 3) - c)));
+					}
+				}
+			}
+			else if (std::regex_search(token, match, dec))
+			{
+				if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+				{
+					error = true;
+					error_type = ErrorType::InvalidValue;
+					return static_cast<unsigned char>(0);
+				}
+				std::istringstream dec_str(match.str());
+				dec_str >> value;
+			}
+			return static_cast<unsigned char>(value & 0xFF);
+		};
+		auto ProcessDataWord = [this, &token, &error, &error_type]()
+		{
+			unsigned short value = 0;
+			if (isdigit(static_cast<unsigned char>(token[0])))
+			{
+				static const std::regex hex("0x[a-fA-F0-9]{1,}");
+				static const std::regex bin("0b[0-1]{1,16}");
+				static const std::regex dec("[0-9]{1,}");
+				std::smatch match;
+				if (std::regex_search(token, match, hex))
+				{
+					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+					{
+						error = true;
+						error_type = ErrorType::InvalidValue;
+						return static_cast<unsigned short>(0);
+					}
+					std::istringstream hex_str(match.str());
+					hex_str >> std::hex >> value;
+				}
+				else if (std::regex_search(token, match, bin))
+				{
+					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+					{
+						error = true;
+						error_type = ErrorType::InvalidValue;
+						return static_cast<unsigned short>(0);
+					}
+					for (size_t c = 0; c < match.str().size() - 2; ++c)
+					{
+						if (match.str()[2 + c] == '1')
+						{
+							value |= (0x8000 >> (15 - ((match.str().size() - 3) - c)));
+						}
+					}
+				}
+				else if (std::regex_search(token, match, dec))
+				{
+					if (match.prefix().str().size() > 0 || match.suffix().str().size() > 0)
+					{
+						error = true;
+						error_type = ErrorType::InvalidValue;
+						return static_cast<unsigned short>(0);
+					}
+					std::istringstream dec_str(match.str());
+					dec_str >> value;
+				}
+			}
+			else
+			{
+				unsigned short reference_address = static_cast<unsigned short>((current_address + ((align && ProgramData.size() % 2 != 0) ? 1 : 0)) - 0x200);
+				auto symbol = SymbolIndex.find(token);
+				if (symbol != SymbolIndex.end())
+				{
+					const Symbol &s = SymbolTable[symbol->second];
+					if (s.Location > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+					{
+						error = true;
+						error_type = ErrorType::Only4KBSupported;
+						return static_cast<unsigned short>(0);
+					}
+					value = s.Location;
+					LabelReferenceList.push_back({ s.Name, current_line_number, reference_address, false, false });
+				}
+				else
+				{
+					UnresolvedReferenceList.push_back({ std::move(token), current_line_number, reference_address, false, false });
+					LabelReferenceList.push_back(UnresolvedReferenceList.back());
+				}
+			}
+			return value;
+		};
+		auto ProcessStringDataByte = [this, &error, &error_type](unsigned char data)
+		{
+			ProgramData.push_back(data);
+			++current_address;
+			if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+			{
+				error = true;
+				error_type = ErrorType::Only4KBSupported;
+			}
+		};
+		auto FollowsSkip = [this]()
+		{
+			if (InstructionLocationList.size() == 0)
+			{
+				return false;
+			}
+			const InstructionLocationData &previous = InstructionLocationList.back();
+			return previous.Size == 2 && previous.Offset + 2 == ProgramData.size() && IsSkipOpcode((ProgramData[previous.Offset] << 8) | ProgramData[previous.Offset + 1]);
+		};
+		auto ProcessExpandedOpcode = [this](unsigned short opcode)
+		{
+			InstructionLocationList.push_back({ ProgramData.size(), 2, current_line_number });
+			ProgramData.push_back(opcode >> 8);
+			ProgramData.push_back(opcode & 0xFF);
+			current_address += 2;
+		};
+		auto ProcessExpansion = [this, &error, &error_type, &FollowsSkip, &ProcessExpandedOpcode](const std::vector<unsigned short> &OpcodeList)
+		{
+			if (OpcodeList.size() > 1 && FollowsSkip())
+			{
+				error = true;
+				error_type = ErrorType::ExpansionAfterSkip;
+				return;
+			}
+			for (auto opcode : OpcodeList)
+			{
+				ProcessExpandedOpcode(opcode);
+			}
+			if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+			{
+				error = true;
+				error_type = ErrorType::Only4KBSupported;
+			}
+		};
+		for (size_t i = 0; i < characters_read; ++i)
+		{
+			switch (line_data[i])
+			{
+				case '\\':
+				{
+					if (string_mode)
+					{
+						if (!escape_mode)
+						{
+							escape_mode = true;
+						}
+						else
+						{
+							switch (token_type)
+							{
+								case TokenType::Origin:
+								{
+									token += line_data[i];
+									break;
+								}
+								case TokenType::DataByte:
+								{
+									ProcessStringDataByte(line_data[i]);
+									break;
+								}
+							}
+							escape_mode = false;
+						}
+					}
+					break;
+				}
+				case ';':
+				{
+					if (!string_mode)
+					{
+						if (!comment)
+						{
+							if (!pointer_mode)
+							{
+								comment = true;
+							}
+							else
+							{
+								error = true;
+							}
+						}
+					}
+					else
+					{
+						switch (token_type)
+						{
+							case TokenType::DataByte:
+							{
+								ProcessStringDataByte(line_data[i]);
+								break;
+							}
+						}
+						if (escape_mode)
+						{
+							escape_mode = false;
+						}
+					}
+					break;
+				}
+				case ' ':
+				{
+					if (!string_mode)
+					{
+						if (token.size() > 0 && !comment && !pointer_mode)
+						{
+							switch (token_type)
+							{
+								case TokenType::None:
+								{
+									bool valid_token = false;
+									for (size_t c = 0; c < token.size(); ++c)
+									{
+										u_token += toupper(static_cast<unsigned char>(token[c]));
+									}
+									for (auto t : TokenList)
+									{
+										if (u_token == t)
+										{
+											valid_token = true;
+											if (t == "OUTPUT")
+											{
+												token_type = TokenType::Output;
+											}
+											else if (t == "EXTENSION")
+											{
+												token_type = TokenType::Extension;
+											}
+											else if (t == "ALIGN")
+											{
+												token_type = TokenType::Align;
+											}
+											else if (t == "RELOCATABLE")
+											{
+												token_type = TokenType::Relocatable;
+											}
+											else if (t == "ORG")
+											{
+												token_type = TokenType::Origin;
+											}
+											else if (t == "INCBIN")
+											{
+												token_type = TokenType::BinaryInclude;
+											}
+											else if (t == "DB")
+											{
+												token_type = TokenType::DataByte;
+											}
+											else if (t == "DW")
+											{
+												token_type = TokenType::DataWord;
+											}
+											else if (t == "SCD")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::ScrollDown;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+												if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::SuperCHIP11Required;
+													break;
+												}
+											}
+											else if (t == "SCU")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::ScrollUp;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+												if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::XOCHIPRequired;
+													break;
+												}
+											}
+											else if (t == "CLS")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::ClearScreen;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											}
+											else if (t == "RET")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Return;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											}
+											else if (t == "SCR")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::ScrollRight;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+												if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::SuperCHIP11Required;
+													break;
+												}
+											}
+											else if (t == "SCL")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::ScrollLeft;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+												if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::SuperCHIP11Required;
+													break;
+												}
+											}
+											else if (t == "EXIT")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Exit;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+												if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::SuperCHIP10Required;
+													break;
+												}
+											}
+											else if (t == "LOW")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Low;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+												if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::SuperCHIP10Required;
+													break;
+												}
+											}
+											else if (t == "HIGH")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::High;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+												if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::SuperCHIP10Required;
+													break;
+												}
+											}
+											else if (t == "JP")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Jump;
+												current_instruction.OperandMinimum = 1;
+												current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "CALL")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Call;
+												current_instruction.OperandMinimum = 1;
+												current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "SE")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::SkipEqual;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "SNE")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::SkipNotEqual;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "LD")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Load;
+												current_instruction.OperandMinimum = 2;
+												current_instruction.OperandMaximum = 3;
+											}
+											else if (t == "ADD")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Add;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "OR")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Or;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "AND")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::And;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "XOR")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Xor;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "SUB")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Subtract;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "SHR")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::ShiftRight;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "SUBN")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::SubtractN;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "ROR")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::RotateRight;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "ROL")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::RotateLeft;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "TEST")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Test;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+												if (CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::HyperCHIP64Required;
+													break;
+												}
+											}
+											else if (t == "NOT")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Not;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "SHL")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::ShiftLeft;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "RND")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Random;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "DRW")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Draw;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 3;
+											}
+											else if (t == "SKP")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::SkipKeyPressed;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											}
+											else if (t == "SKNP")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::SkipKeyNotPressed;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											}
+											else if (t == "PLANE")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Plane;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+												if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension!= ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::XOCHIPRequired;
+													break;
+												}
+											}
+											else if (t == "AUDIO")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Audio;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+												if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::XOCHIPRequired;
+													break;
+												}
+											}
+											else if (t == "PITCH")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Pitch;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+												if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::XOCHIPRequired;
+													break;
+												}
+											}
+											else if (t == "VOLUME")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Volume;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+												if (CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::HyperCHIP64Required;
+													break;
+												}
+											}
+											else if (t == "VOICE")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Voice;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+												if (CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::HyperCHIP64Required;
+													break;
+												}
+											}
+											else if (t == "CHANNEL")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Channel;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+												if (CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::HyperCHIP64Required;
+													break;
+												}
+											}
+											else if (t == "MUL")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Multiply;
+												current_instruction.OperandMinimum = 2;
+												current_instruction.OperandMaximum = 3;
+											}
+											else if (t == "DIV")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Divide;
+												current_instruction.OperandMinimum = 2;
+												current_instruction.OperandMaximum = 3;
+											}
+											else if (t == "ADD16")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Add16;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 3;
+											}
+											else if (t == "MEMCPY")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::MemoryCopy;
+												current_instruction.OperandMinimum = 3;
+												current_instruction.OperandMaximum = 4;
+											}
+											else if (t == "MEMSET")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::MemorySet;
+												current_instruction.OperandMinimum = 3;
+												current_instruction.OperandMaximum = 4;
+											}
+											else if (t == "SWITCH")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::Switch;
+												current_instruction.OperandMinimum = 2;
+												current_instruction.OperandMaximum = 129;
+											}
+											else if (t == "ASSERT_CYCLES")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::AssertCycles;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											}
+											else if (t == "INIT_BEGIN")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::InitBegin;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											}
+											else if (t == "INIT_END")
+											{
+												token_type = TokenType::Instruction;
+												current_instruction.Type = InstructionType::InitEnd;
+												current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											}
+											else if (t == "LONG")
+											{
+												long_mode = true;
+											}
+											token = "";
+											u_token = "";
+										}
+									}
+									if (!valid_token)
+									{
+										error = true;
+										error_type = ErrorType::InvalidToken;
+									}
+									break;
+								}
+							}
+						}
+					}
+					else
+					{
+						switch (token_type)
+						{
+							case TokenType::BinaryInclude:
+							{
+								token += line_data[i];
+								break;
+							}
+							case TokenType::DataByte:
+							{
+								ProcessStringDataByte(line_data[i]);
+								break;
+							}
+						}
+						if (escape_mode)
+						{
+							escape_mode = false;
+						}
+					}
+					break;
+				}
+				case '"':
+				{
+					if (!comment)
+					{
+						if (!string_mode)
+						{
+							switch (token_type)
+							{
+								case TokenType::BinaryInclude:
+								{
+									if (token.size() > 0)
+									{
+										error = true;
+										break;
+									}
+									string_mode = true;
+									break;
+								}
+								case TokenType::DataByte:
+								{
+									string_mode = true;
+									break;
+								}
+							}
+						}
+						else
+						{
+							if (!escape_mode)
+							{
+								string_mode = false;
+							}
+							else
+							{
+								switch (token_type)
+								{
+									case TokenType::DataByte:
+									{
+										ProcessStringDataByte(line_data[i]);
+										break;
+									}
+								}
+								escape_mode = false;
+							}
+						}
+					}
+					break;
+				}
+				case '[':
+				{
+					if (!comment)
+					{
+						if (!string_mode)
+						{
+							if (current_operand.Type == OperandType::None)
+							{
+								if (!pointer_mode)
+								{
+									current_operand.Type = OperandType::Pointer;
+									pointer_mode = true;
+								}
+								else
+								{
+									error = true;
+								}
+							}
+							else
+							{
+								error = true;
+							}
+						}
+						else
+						{
+							switch (token_type)
+							{
+								case TokenType::DataByte:
+								{
+									ProcessStringDataByte(line_data[i]);
+									break;
+								}
+							}
+							if (escape_mode)
+							{
+								escape_mode = false;
+							}
+						}
+					}
+					break;
+				}
+				case ']':
+				{
+					if (!comment)
+					{
+						if (!string_mode)
+						{
+							if (current_operand.Type == OperandType::Pointer)
+							{
+								if (pointer_mode)
+								{
+									pointer_mode = false;
+								}
+								else
+								{
+									error = true;
+								}
+							}
+							else
+							{
+								error = true;
+							}
+						}
+						else
+						{
+							switch (token_type)
+							{
+								case TokenType::DataByte:
+								{
+									ProcessStringDataByte(line_data[i]);
+									break;
+								}
+							}
+							if (escape_mode)
+							{
+								escape_mode = false;
+							}
+						}
+					}
+					break;
+				}
+				case ',':
+				{
+					if (!comment)
+					{
+						for (size_t c = 0; c < token.size(); ++c)
+						{
+							u_token += toupper(static_cast<unsigned char>(token[c]));
+						}
+						switch (token_type)
+						{
+							case TokenType::Instruction:
+							{
+								if (current_operand.Type != OperandType::ImmediateValue && current_operand.Type != OperandType::Pointer)
+								{
+									bool operand_type_found = false;
+									for (auto r : RegisterList)
+									{
+										if (u_token == r)
+										{
+											operand_type_found = true;
+											token = u_token;
+											current_operand.Type = OperandType::Register;
+											break;
+										}
+									}
+									if (!operand_type_found)
+									{
+										if (u_token == "I")
+										{
+											current_operand.Type = OperandType::AddressRegister;
+										}
+										else if (u_token == "DT")
+										{
+											current_operand.Type = OperandType::DelayTimer;
+										}
+										else if (u_token == "ST")
+										{
+											current_operand.Type = OperandType::SoundTimer;
+										}
+										else if (u_token == "K")
+										{
+											current_operand.Type = OperandType::Key;
+										}
+										else if (u_token == "F")
+										{
+											current_operand.Type = OperandType::LoResFont;
+										}
+										else if (u_token == "HF")
+										{
+											current_operand.Type = OperandType::HiResFont;
+										}
+										else if (u_token == "B")
+										{
+											current_operand.Type = OperandType::BCD;
+										}
+										else if (u_token == "R")
+										{
+											current_operand.Type = OperandType::UserRPL;
+										}
+										else if (current_instruction.Type == InstructionType::MemoryCopy || current_instruction.Type == InstructionType::MemorySet || current_instruction.Type == InstructionType::Switch || current_instruction.Type == InstructionType::AssertCycles)
+										{
+											current_operand.Type = OperandType::Label;
+										}
+									}
+								}
+								current_operand.Data = std::move(token);
+								current_instruction.OperandList.push_back(current_operand);
+								current_operand = { OperandType::None, "" };
+								u_token = "";
+								break;
+							}
+							case TokenType::BinaryInclude:
+							{
+								if (!string_mode)
+								{
+									error = true;
+									break;
+								}
+								break;
+							}
+							case TokenType::DataByte:
+							{
+								if (!string_mode)
+								{
+									if (token.size() > 0)
+									{
+										unsigned char value = ProcessDataByte();
+										if (error)
+										{
+											break;
+										}
+										ProgramData.push_back(value);
+										if (align && ProgramData.size() % 2 != 0)
+										{
+											ProgramData.push_back(0x00);
+											current_address += 2;
+										}
+										else
+										{
+											++current_address;
+										}
+										if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+										{
+											error = true;
+											error_type = ErrorType::Only4KBSupported;
+											break;
+										}
+										token = "";
+										u_token = "";
+									}
+								}
+								else
+								{
+									ProcessStringDataByte(line_data[i]);
+									if (escape_mode)
+									{
+										escape_mode = false;
+									}
+								}
+								break;
+							}
+							case TokenType::DataWord:
+							{
+								unsigned short value = ProcessDataWord();
+								if (error)
+								{
+									break;
+								}
+								if (align && ProgramData.size() % 2 != 0)
+								{
+									ProgramData.push_back(0x00);
+									++current_address;
+									if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+									{
+										error = true;
+										error_type = ErrorType::Only4KBSupported;
+										break;
+									}
+								}
+								ProgramData.push_back(static_cast<unsigned char>(value >> 8));
+								ProgramData.push_back(static_cast<unsigned char>(value & 0xFF));
+								current_address += 2;
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+									break;
+								}
+								token = "";
+								u_token = "";
+								break;
+							}
+							default:
+							{
+								error = true;
+								break;
+							}
+						}
+					}
+					break;
+				}
+				case ':':
+				{
+					if (!comment)
+					{
+						if (!string_mode)
+						{
+							for (size_t c = 0; c < token.size(); ++c)
+							{
+								u_token += toupper(static_cast<unsigned char>(token[c]));
+							}
+							for (auto t : TokenList)
+							{
+								if (u_token == t)
+								{
+									error = true;
+									error_type = ErrorType::ReservedToken;
+									break;
+								}
+							}
+							if (error)
+							{
+								break;
+							}
+							if (u_token == "I")
+							{
+								error = true;
+								error_type = ErrorType::ReservedToken;
+								break;
+							}
+							SymbolIndex.emplace(token, SymbolTable.size());
+							Symbol Label = { std::move(token), SymbolType::Label, current_address };
+							SymbolTable.push_back(Label);
+							token = "";
+						}
+						else
+						{
+							switch (token_type)
+							{
+								case TokenType::BinaryInclude:
+								{
+									token += line_data[i];
+									break;
+								}
+								case TokenType::DataByte:
+								{
+									ProcessStringDataByte(line_data[i]);
+									break;
+								}
+							}
+							if (escape_mode)
+							{
+								escape_mode = false;
+							}
+						}
+					}
+					break;
+				}
+				case '\0':
+				{
+					if (string_mode)
+					{
+						error = true;
+						break;
+					}
+					if (token.size() > 0)
+					{
+						bool valid_token = false;
+						for (size_t c = 0; c < token.size(); ++c)
+						{
+							u_token += toupper(static_cast<unsigned char>(token[c]));
+						}
+						switch (token_type)
+						{
+							case TokenType::None:
+							{
+								for (auto t : TokenList)
+								{
+									if (u_token == t)
+									{
+										valid_token = true;
+										if (t == "SCD")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::ScrollDown;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											error = true;
+											error_type = (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::SuperCHIP11Required : ErrorType::TooFewOperands;
+										}
+										else if (t == "SCU")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::ScrollUp;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											error = true;
+											error_type = (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::XOCHIPRequired : ErrorType::TooFewOperands;
+										}
+										else if (t == "CLS")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::ClearScreen;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+										}
+										else if (t == "RET")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Return;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+										}
+										else if (t == "SCR")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::ScrollRight;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::SuperCHIP11Required;
+											}
+										}
+										else if (t == "SCL")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::ScrollLeft;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::SuperCHIP11Required;
+											}
+										}
+										else if (t == "EXIT")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Exit;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::SuperCHIP10Required;
+											}
+										}
+										else if (t == "LOW")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Low;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::SuperCHIP10Required;
+											}
+										}
+										else if (t == "HIGH")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::High;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::SuperCHIP10Required;
+											}
+										}
+										else if (t == "JP")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Jump;
+											current_instruction.OperandMinimum = 1;
+											current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "CALL")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Call;
+											current_instruction.OperandMinimum = 1;
+											current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "SE")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::SkipEqual;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "SNE")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::SkipNotEqual;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "LD")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Load;
+											current_instruction.OperandMinimum = 2;
+											current_instruction.OperandMaximum = 3;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "ADD")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Add;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "OR")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Or;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "AND")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::And;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "XOR")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Xor;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "SUB")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Subtract;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "SHR")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::ShiftRight;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "SUBN")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::SubtractN;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "ROR")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::RotateRight;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "ROL")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::RotateLeft;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "TEST")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Test;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
+										}
+										else if (t == "NOT")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Not;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "SHL")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::ShiftLeft;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "RND")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Random;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "DRW")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Draw;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 3;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "SKP")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::SkipKeyPressed;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "SKNP")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::SkipKeyNotPressed;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "PLANE")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Plane;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											error = true;
+											error_type = (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::XOCHIPRequired : ErrorType::TooFewOperands;
+										}
+										else if (t == "AUDIO")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Audio;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+											if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::XOCHIPRequired;
+											}
+										}
+										else if (t == "PITCH")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Pitch;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											error = true;
+											error_type = (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::XOCHIPRequired : ErrorType::TooFewOperands;
+										}
+										else if (t == "VOLUME")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Volume;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											error = true;
+											error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
+										}
+										else if (t == "VOICE")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Voice;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											error = true;
+											error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
+										}
+										else if (t == "CHANNEL")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Channel;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 1;
+											error = true;
+											error_type = (CurrentExtension != ExtensionType::HyperCHIP64) ? ErrorType::HyperCHIP64Required : ErrorType::TooFewOperands;
+										}
+										else if (t == "MUL")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Multiply;
+											current_instruction.OperandMinimum = 2;
+											current_instruction.OperandMaximum = 3;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "DIV")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Divide;
+											current_instruction.OperandMinimum = 2;
+											current_instruction.OperandMaximum = 3;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "ADD16")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Add16;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 3;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "MEMCPY")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::MemoryCopy;
+											current_instruction.OperandMinimum = 3;
+											current_instruction.OperandMaximum = 4;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "MEMSET")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::MemorySet;
+											current_instruction.OperandMinimum = 3;
+											current_instruction.OperandMaximum = 4;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "SWITCH")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::Switch;
+											current_instruction.OperandMinimum = 2;
+											current_instruction.OperandMaximum = 129;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "ASSERT_CYCLES")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::AssertCycles;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 2;
+											error = true;
+											error_type = ErrorType::TooFewOperands;
+										}
+										else if (t == "INIT_BEGIN")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::InitBegin;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+										}
+										else if (t == "INIT_END")
+										{
+											token_type = TokenType::Instruction;
+											current_instruction.Type = InstructionType::InitEnd;
+											current_instruction.OperandMinimum = current_instruction.OperandMaximum = 0;
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case TokenType::Instruction:
+							{
+								valid_token = true;
+								if (current_operand.Type != OperandType::ImmediateValue && current_operand.Type != OperandType::Pointer)
+								{
+									bool operand_type_found = false;
+									for (auto r : RegisterList)
+									{
+										if (u_token == r)
+										{
+											operand_type_found = true;
+											token = u_token;
+											current_operand.Type = OperandType::Register;
+											break;
+										}
+									}
+									if (!operand_type_found)
+									{
+										if (u_token == "I")
+										{
+											current_operand.Type = OperandType::AddressRegister;
+										}
+										else if (u_token == "DT")
+										{
+											current_operand.Type = OperandType::DelayTimer;
+										}
+										else if (u_token == "ST")
+										{
+											current_operand.Type = OperandType::SoundTimer;
+										}
+										else if (u_token == "K")
+										{
+											current_operand.Type = OperandType::Key;
+										}
+										else if (u_token == "F")
+										{
+											current_operand.Type = OperandType::LoResFont;
+										}
+										else if (u_token == "HF")
+										{
+											current_operand.Type = OperandType::HiResFont;
+										}
+										else if (u_token == "B")
+										{
+											current_operand.Type = OperandType::BCD;
+										}
+										else if (u_token == "R")
+										{
+											current_operand.Type = OperandType::UserRPL;
+										}
+										else
+										{
+											current_operand.Type = OperandType::Label;
+										}
+									}
+								}
+								current_operand.Data = std::move(token);
+								current_instruction.OperandList.push_back(current_operand);
+								break;
+							}
+							case TokenType::Output:
+							{
+								for (auto o : OutputTypeList)
+								{
+									if (u_token == o)
+									{
+										valid_token = true;
+										if (o == "BINARY")
+										{
+											CurrentOutputType = OutputType::Binary;
+											Log << "Using binary output mode.\n";
+										}
+										else if (o == "HEXASCIISTRING")
+										{
+											CurrentOutputType = OutputType::HexASCIIString;
+											Log << "Using Hex ASCII String output mode.\n";
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case TokenType::Extension:
+							{
+								for (auto e : ExtensionList)
+								{
+									if (u_token == e)
+									{
+										valid_token = true;
+										if (e == "CHIP8")
+										{
+											CurrentExtension = ExtensionType::CHIP8;
+											Log << "Using the original CHIP-8 instruction set.\n";
+										}
+										else if (e == "SCHIP10")
+										{
+											CurrentExtension = ExtensionType::SuperCHIP10;
+											Log << "Using the SuperCHIP V1.0 extension.\n";
+										}
+										else if (e == "SCHIP11")
+										{
+											CurrentExtension = ExtensionType::SuperCHIP11;
+											Log << "Using the SuperCHIP V1.1 extension.\n";
+										}
+										else if (e == "XOCHIP")
+										{
+											CurrentExtension = ExtensionType::XOCHIP;
+											Log << "Using the XO-CHIP extension.\n";
+										}
+										else if (e == "HCHIP64")
+										{
+											CurrentExtension = ExtensionType::HyperCHIP64;
+											Log << "Using the HyperCHIP-64 extension.\n";
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case TokenType::Align:
+							{
+								for (auto a : ToggleList)
+								{
+									if (u_token == a)
+									{
+										valid_token = true;
+										if (a == "OFF")
+										{
+											align = false;
+										}
+										else if (a == "ON")
+										{
+											align = true;
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case TokenType::Relocatable:
+							{
+								for (auto r : ToggleList)
+								{
+									if (u_token == r)
+									{
+										valid_token = true;
+										if (r == "OFF" && relocatable)
+										{
+											RelocatableList.back().Size = ProgramData.size() - RelocatableList.back().Offset;
+											relocatable = false;
+										}
+										else if (r == "ON" && !relocatable)
+										{
+											RelocatableList.push_back({ ProgramData.size(), 0, current_line_number });
+											relocatable = true;
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case TokenType::Origin:
+							{
+								valid_token = true;
+								unsigned short address = ProcessOrigin();
+								if (error)
+								{
+									break;
+								}
+								if (address < 0x200)
+								{
+									error = true;
+									error_type = ErrorType::ReservedAddress;
+									break;
+								}
+								if (address < current_address)
+								{
+									error = true;
+									error_type = ErrorType::BelowCurrentAddress;
+									break;
+								}
+								if (init_region)
+								{
+									error = true;
+									error_type = ErrorType::UnmatchedInitRegion;
+									break;
+								}
+								current_address = address;
+								origin_used = true;
+								OriginList.push_back({ ProgramData.size(), static_cast<size_t>(current_address - 0x200) });
+								for (size_t a = ProgramData.size(); a < static_cast<size_t>(current_address - 0x200); ++a)
+								{
+									ProgramData.push_back(0x00);
+								}
+								if (relocatable)
+								{
+									RelocatableList.back().Size = OriginList.back().PadOffset - RelocatableList.back().Offset;
+									RelocatableList.push_back({ ProgramData.size(), 0, current_line_number });
+								}
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+									break;
+								}
+								break;
+							}
+							case TokenType::BinaryInclude:
+							{
+								valid_token = true;
+								if (std::find(DependencyList.begin(), DependencyList.end(), token) == DependencyList.end())
+								{
+									DependencyList.push_back(token);
+								}
+								std::shared_ptr<const std::vector<unsigned char>> binary_data = Cache.Load(token);
+								if (!binary_data)
+								{
+									error = true;
+									error_type = ErrorType::BinaryFileDoesNotExist;
+									break;
+								}
+								for (size_t c = 0; c < binary_data->size(); ++c)
+								{
+									ProgramData.push_back((*binary_data)[c]);
+									++current_address;
+									if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+									{
+										error = true;
+										error_type = ErrorType::Only4KBSupported;
+										break;
+									}
+								}
+								break;
+							}
+							case TokenType::DataByte:
+							{
+								valid_token = true;
+								if (token.size() > 0)
+								{
+									unsigned char value = ProcessDataByte();
+									if (error)
+									{
+										break;
+									}
+									ProgramData.push_back(value);
+									if (align && ProgramData.size() % 2 != 0)
+									{
+										ProgramData.push_back(0x00);
+										current_address += 2;
+									}
+									else
+									{
+										++current_address;
+									}
+									if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+									{
+										error = true;
+										error_type = ErrorType::Only4KBSupported;
+										break;
+									}
+								}
+								break;
+							}
+							case TokenType::DataWord:
+							{
+								valid_token = true;
+								unsigned short value = ProcessDataWord();
+								if (error)
+								{
+									break;
+								}
+								if (align && ProgramData.size() % 2 != 0)
+								{
+									ProgramData.push_back(0x00);
+									++current_address;
+									if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+									{
+										error = true;
+										error_type = ErrorType::Only4KBSupported;
+										break;
+									}
+								}
+								ProgramData.push_back(static_cast<unsigned char>(value >> 8));
+								ProgramData.push_back(static_cast<unsigned char>(value & 0xFF));
+								current_address += 2;
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+								}
+								break;
+							}
+						}
+						if (error)
+						{
+							break;
+						}
+						if (!valid_token)
+						{
+							error = true;
+							error_type = ErrorType::InvalidToken;
+							break;
+						}
+					}
+					if (token_type == TokenType::Instruction)
+					{
+						size_t instruction_offset = ProgramData.size();
+						switch (current_instruction.Type)
+						{
+							case InstructionType::ScrollDown:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::ImmediateValue:
+									{
+										unsigned char value = Process8BitImmediateValueOperand(0);
+										if (error)
+										{
+											break;
+										}
+										ProgramData.push_back(0x00);
+										ProgramData.push_back(0xC0 | (value & 0xF));
+										current_address += 2;
+										if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+										{
+											error = true;
+											error_type = ErrorType::Only4KBSupported;
+											break;
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::ScrollUp:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::ImmediateValue:
+									{
+										unsigned char value = Process8BitImmediateValueOperand(0);
+										if (error)
+										{
+											break;
+										}
+										ProgramData.push_back(0x00);
+										ProgramData.push_back(0xD0 | (value & 0xF));
+										current_address += 2;
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::ClearScreen:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								ProgramData.push_back(0x00);
+								ProgramData.push_back(0xE0);
+								current_address += 2;
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+									break;
+								}
+								break;
+							}
+							case InstructionType::Return:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								ProgramData.push_back(0x00);
+								ProgramData.push_back(0xEE);
+								current_address += 2;
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+									break;
+								}
+								break;
+							}
+							case InstructionType::ScrollRight:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								ProgramData.push_back(0x00);
+								ProgramData.push_back(0xFB);
+								current_address += 2;
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+									break;
+								}
+								break;
+							}
+							case InstructionType::ScrollLeft:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								ProgramData.push_back(0x00);
+								ProgramData.push_back(0xFC);
+								current_address += 2;
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+									break;
+								}
+								break;
+							}
+							case InstructionType::Exit:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								ProgramData.push_back(0x00);
+								ProgramData.push_back(0xFD);
+								current_address += 2;
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+									break;
+								}
+								break;
+							}
+							case InstructionType::Low:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								ProgramData.push_back(0x00);
+								ProgramData.push_back(0xFE);
+								current_address += 2;
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+									break;
+								}
+								break;
+							}
+							case InstructionType::High:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								ProgramData.push_back(0x00);
+								ProgramData.push_back(0xFF);
+								current_address += 2;
+								if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+									break;
+								}
+								break;
+							}
+							case InstructionType::Jump:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Label:
+									{
+										ProcessLabelOperand(0, 0x1);
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg = 0x0;
+										if (!ProcessRegisterOperand(0, reg))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (reg != 0x0 && CurrentExtension == ExtensionType::HyperCHIP64)
+										{
+											ProgramData.push_back(0xF0 | (reg & 0xF));
+											ProgramData.push_back(0xB1);
+											current_address += 2;
+										}
+										switch (current_instruction.OperandList[1].Type)
+										{
+											case OperandType::Label:
+											{
+												ProcessLabelOperand(1, 0xB);
+												break;
+											}
+											case OperandType::ImmediateValue:
+											{
+												ProcessAddressImmediateValueOperand(1, 0xB);
+												break;
+											}
+										}
+										break;
+									}
+									case OperandType::ImmediateValue:
+									{
+										ProcessAddressImmediateValueOperand(0, 0x1);
+										break;
+									}
+									case OperandType::Pointer:
+									{
+										if (CurrentExtension != ExtensionType::HyperCHIP64)
+										{
+											error = true;
+											error_type = ErrorType::HyperCHIP64Required;
+											break;
+										}
+										unsigned char reg = 0x0;
+										if (!ProcessAddressRegisterOffsetPointerOperand(0, reg))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										ProgramData.push_back(0xF0 | (reg & 0xF));
+										ProgramData.push_back(0x20);
+										current_address += 2;
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Call:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Label:
+									{
+										ProcessLabelOperand(0, 0x2);
+										break;
+									}
+									case OperandType::ImmediateValue:
+									{
+										ProcessAddressImmediateValueOperand(0, 0x2);
+										break;
+									}
+									case OperandType::Pointer:
+									{
+										unsigned char reg = 0x0;
+										if (!ProcessAddressRegisterOffsetPointerOperand(0, reg))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										ProgramData.push_back(0xF0 | (reg & 0xF));
+										ProgramData.push_back(0x21);
+										current_address += 2;
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::SkipEqual:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										switch (current_instruction.OperandList[1].Type)
+										{
+											case OperandType::Register:
+											{
+												unsigned char reg2 = 0x0;
+												if (!ProcessRegisterOperand(1, reg2))
+												{
+													error = true;
+													error_type = ErrorType::InvalidRegister;
+													break;
+												}
+												ProgramData.push_back(0x50 | (reg1 & 0xF));
+												ProgramData.push_back(reg2 << 4);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+											case OperandType::ImmediateValue:
+											{
+												unsigned char value = Process8BitImmediateValueOperand(1);
+												if (error)
+												{
+													break;
+												}
+												ProgramData.push_back(0x30 | (reg1 & 0xF));
+												ProgramData.push_back(value);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::SkipNotEqual:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										switch (current_instruction.OperandList[1].Type)
+										{
+											case OperandType::Register:
+											{
+													unsigned char reg2 = 0x0;
+												if (!ProcessRegisterOperand(0, reg2))
+												{
+													error = true;
+													error_type = ErrorType::InvalidRegister;
+													break;
+												}
+												ProgramData.push_back(0x90 | (reg1 & 0xF));
+												ProgramData.push_back(reg2 << 4);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+											case OperandType::ImmediateValue:
+											{
+												unsigned char value = Process8BitImmediateValueOperand(1);
+												if (error)
+												{
+													break;
+												}
+												ProgramData.push_back(0x40 | (reg1 & 0xF));
+												ProgramData.push_back(value);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Load:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										switch (current_instruction.OperandList[1].Type)
+										{
+											case OperandType::Register:
+											{
+												unsigned char reg2 = 0x0;
+												if (!ProcessRegisterOperand(1, reg2))
+												{
+													error = true;
+													error_type = ErrorType::InvalidRegister;
+													break;
+												}
+												if (current_instruction.OperandList.size() == 2)
+												{
+													ProgramData.push_back(0x80 | (reg1 & 0xF));
+													ProgramData.push_back(reg2 << 4);
+												}
+												else
+												{
+													if (current_instruction.OperandList[2].Type == OperandType::Pointer)
+													{
+														std::string uptr_data;
+														for (size_t c = 0; c < current_instruction.OperandList[2].Data.size(); ++c)
+														{
+															uptr_data += toupper(static_cast<unsigned char>(current_instruction.OperandList[2].Data[c]));
+														}
+														if (uptr_data == "I")
+														{
+															if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+															{
+																if (reg1 != 0x0)
+																{
+																	error = true;
+																	error_type = ErrorType::XOCHIPRequired;
+																	break;
+																}
+																ProgramData.push_back(0xF0 | (reg2 & 0xF));
+																ProgramData.push_back(0x65);
+															}
+															else
+															{
+																ProgramData.push_back(0x50 | (reg1 & 0xF));
+																ProgramData.push_back((reg2 << 4) | 0x3);
+															}
+														}
+													}
+												}
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+											case OperandType::ImmediateValue:
+											{
+												unsigned char value = Process8BitImmediateValueOperand(1);
+												if (error)
+												{
+													break;
+												}
+												ProgramData.push_back(0x60 | (reg1 & 0xF));
+												ProgramData.push_back(value);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+											case OperandType::DelayTimer:
+											{
+												ProgramData.push_back(0xF0 | (reg1 & 0xF));
+												ProgramData.push_back(0x07);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+											case OperandType::Pointer:
+											{
+												std::string uptr_data;
+												for (size_t c = 0; c < current_instruction.OperandList[1].Data.size(); ++c)
+												{
+													uptr_data += toupper(static_cast<unsigned char>(current_instruction.OperandList[1].Data[c]));
+												}
+												if (uptr_data == "I")
+												{
+													ProgramData.push_back(0xF0 | (reg1 & 0xF));
+													ProgramData.push_back(0x65);
+													current_address += 2;
+													if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+													{
+														error = true;
+														error_type = ErrorType::Only4KBSupported;
+														break;
+													}
+												}
+												break;
+											}
+											case OperandType::Key:
+											{
+												ProgramData.push_back(0xF0 | (reg1 & 0xF));
+												ProgramData.push_back(0x0A);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+											case OperandType::UserRPL:
+											{
+												if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)														
+												{
+													error = true;
+													error_type = ErrorType::SuperCHIP10Required;
+													break;
+												}
+												ProgramData.push_back(0xF0 | (reg1 & 0xF));
+												ProgramData.push_back(0x85);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+										}
+										break;
+									}
+									case OperandType::AddressRegister:
+									{
+										switch (current_instruction.OperandList[1].Type)
+										{
+											case OperandType::Label:
+											{
+												ProcessLabelOperand(1, 0xA);
+												break;
+											}
+											case OperandType::ImmediateValue:
+											{
+												ProcessAddressImmediateValueOperand(1, 0xA);
+												break;
+											}
+											case OperandType::Pointer:
+											{
+												if (CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::HyperCHIP64Required;
+													break;
+												}
+												unsigned char reg = 0x0;
+												if (!ProcessAddressRegisterOffsetPointerOperand(1, reg))
+												{
+													error = true;
+													error_type = ErrorType::InvalidRegister;
+													break;
+												}
+												ProgramData.push_back(0xF0 | (reg & 0xF));
+												ProgramData.push_back(0xA2);
+												current_address += 2;
+												break;
+											}
+										}
+										break;
+									}
+									case OperandType::DelayTimer:
+									{
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg = 0x0;
+											if (!ProcessRegisterOperand(1, reg))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0xF0 | (reg & 0xF));
+											ProgramData.push_back(0x15);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+									case OperandType::SoundTimer:
+									{
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg = 0x0;
+											if (!ProcessRegisterOperand(1, reg))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0xF0 | (reg & 0xF));
+											ProgramData.push_back(0x18);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+									case OperandType::Pointer:
+									{
+										std::string uptr_data;
+										for (size_t c = 0; c < current_instruction.OperandList[0].Data.size(); ++c)
+										{
+											uptr_data += toupper(static_cast<unsigned char>(current_instruction.OperandList[0].Data[c]));
+										}
+										if (uptr_data == "I")
+										{
+											if (current_instruction.OperandList[1].Type == OperandType::Register)
+											{
+												unsigned char reg1 = 0x0;
+												if (!ProcessRegisterOperand(1, reg1))
+												{
+													error = true;
+													error_type = ErrorType::InvalidRegister;
+													break;
+												}
+												if (current_instruction.OperandList.size() == 2)
+												{
+													ProgramData.push_back(0xF0 | (reg1 & 0xF));
+													ProgramData.push_back(0x55);
+												}
+												else
+												{
+													if (current_instruction.OperandList[2].Type == OperandType::Register)
+													{
+														unsigned char reg2 = 0x0;
+														if (!ProcessRegisterOperand(2, reg2))
+														{
+															error = true;
+															error_type = ErrorType::InvalidRegister;
+															break;
+														}
+														if (CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+														{
+															if (reg1 != 0x0)
+															{
+																error = true;
+																error_type = ErrorType::XOCHIPRequired;
+																break;
+															}
+															ProgramData.push_back(0xF0 | (reg2 & 0xF));
+															ProgramData.push_back(0x55);
+														}
+														else
+														{
+															ProgramData.push_back(0x50 | (reg1 & 0xF));
+															ProgramData.push_back((reg2 << 4) | 0x2);
+														}
+													}
+												}
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+											}
+										}
+										break;
+									}
+									case OperandType::LoResFont:
+									{
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg = 0x0;
+											if (!ProcessRegisterOperand(1, reg))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0xF0 | (reg & 0xF));
+											ProgramData.push_back(0x29);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+									case OperandType::HiResFont:
+									{
+										if (CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+										{
+											error = true;
+											error_type = ErrorType::SuperCHIP11Required;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg = 0x0;
+											if (!ProcessRegisterOperand(1, reg))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0xF0 | (reg & 0xF));
+											ProgramData.push_back(0x30);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+									case OperandType::BCD:
+									{
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg = 0x0;
+											if (!ProcessRegisterOperand(1, reg))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0xF0 | (reg & 0xF));
+											ProgramData.push_back(0x33);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+									case OperandType::UserRPL:
+									{
+										if (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+										{
+											error = true;
+											error_type = ErrorType::SuperCHIP10Required;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg = 0x0;
+											if (!ProcessRegisterOperand(1, reg))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0xF0 | (reg & 0xF));
+											ProgramData.push_back(0x75);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Add:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										switch (current_instruction.OperandList[1].Type)
+										{
+											case OperandType::Register:
+											{
+												unsigned char reg2 = 0x0;
+												if (!ProcessRegisterOperand(1, reg2))
+												{
+													error = true;
+													error_type = ErrorType::InvalidRegister;
+													break;
+												}
+												ProgramData.push_back(0x80 | (reg1 & 0xF));
+												ProgramData.push_back((reg2 << 4) | 0x4);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+											case OperandType::ImmediateValue:
+											{
+												unsigned char value = Process8BitImmediateValueOperand(1);
+												if (error)
+												{
+													break;
+												}
+												ProgramData.push_back(0x70 | (reg1 & 0xF));
+												ProgramData.push_back(value);
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+													break;
+												}
+												break;
+											}
+										}
+										break;
+									}
+									case OperandType::AddressRegister:
+									{
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg = 0x0;
+											if (!ProcessRegisterOperand(1, reg))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0xF0 | (reg & 0xF));
+											ProgramData.push_back(0x1E);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Or:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0x80 | (reg1 & 0xF));
+											ProgramData.push_back((reg2 << 4) | 0x1);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::And:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0x80 | (reg1 & 0xF));
+											ProgramData.push_back((reg2 << 4) | 0x2);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Xor:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0x80 | (reg1 & 0xF));
+											ProgramData.push_back((reg2 << 4) | 0x3);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Subtract:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0x80 | (reg1 & 0xF));
+											ProgramData.push_back((reg2 << 4) | 0x5);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::ShiftRight:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidValue;
+												break;
+											}
+											ProgramData.push_back(0x80 | (reg1 & 0xF));
+											ProgramData.push_back((reg2 << 4) | 0x6);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::SubtractN:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if(!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0x80 | (reg1 & 0xF));
+											ProgramData.push_back((reg2 << 4) | 0x7);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Plane:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::ImmediateValue:
+									{
+										unsigned char value = Process8BitImmediateValueOperand(0);
+										if (error)
+										{
+											break;
+										}
+										ProgramData.push_back(0xF0 | (value & 0xF));
+										ProgramData.push_back(0x01);
+										current_address += 2;
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Audio:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								ProgramData.push_back(0xF0);
+								ProgramData.push_back(0x02);
+								current_address += 2;
+								break;
+							}
+							case InstructionType::Pitch:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg = 0x0;
+										if (!ProcessRegisterOperand(0, reg))
+										{
+											break;
+										}
+										ProgramData.push_back(0xF0 | (reg & 0xF));
+										ProgramData.push_back(0x3A);
+										current_address += 2;
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::RotateRight:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											if (CurrentExtension == ExtensionType::HyperCHIP64)
+											{
+												ProgramData.push_back(0x80 | (reg1 & 0xF));
+												ProgramData.push_back((reg2 << 4) | 0x8);
+												current_address += 2;
+												break;
+											}
+											if (reg1 == 0xF || reg2 == 0xF)
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											std::vector<unsigned short> OpcodeList;
+											if (reg1 != reg2)
+											{
+												OpcodeList.push_back(0x8000 | (reg1 << 8) | (reg2 << 4));
+											}
+											OpcodeList.push_back(0x8006 | (reg1 << 8) | (reg1 << 4));
+											OpcodeList.push_back(0x3F00);
+											OpcodeList.push_back(0x7080 | (reg1 << 8));
+											ProcessExpansion(OpcodeList);
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::RotateLeft:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											if (CurrentExtension == ExtensionType::HyperCHIP64)
+											{
+												ProgramData.push_back(0x80 | (reg1 & 0xF));
+												ProgramData.push_back((reg2 << 4) | 0x9);
+												current_address += 2;
+												break;
+											}
+											if (reg1 == 0xF || reg2 == 0xF)
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											std::vector<unsigned short> OpcodeList;
+											if (reg1 != reg2)
+											{
+												OpcodeList.push_back(0x8000 | (reg1 << 8) | (reg2 << 4));
+											}
+											OpcodeList.push_back(0x8004 | (reg1 << 8) | (reg1 << 4));
+											OpcodeList.push_back(0x3F00);
+											OpcodeList.push_back(0x7001 | (reg1 << 8));
+											ProcessExpansion(OpcodeList);
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Test:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidValue;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0x80 | (reg1 & 0xF));
+											ProgramData.push_back((reg2 << 4) | 0xA);
+											current_address += 2;
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Not:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidValue;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											if (CurrentExtension == ExtensionType::HyperCHIP64)
+											{
+												ProgramData.push_back(0x80 | (reg1 & 0xF));
+												ProgramData.push_back((reg2 << 4) | 0xB);
+												current_address += 2;
+												break;
+											}
+											if (reg1 == 0xF || reg2 == 0xF)
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											if (reg1 != reg2)
+											{
+												ProcessExpansion({ static_cast<unsigned short>(0x60FF | (reg1 << 8)), static_cast<unsigned short>(0x8005 | (reg1 << 8) | (reg2 << 4)) });
+											}
+											else
+											{
+												ProcessExpansion({ 0x6FFF, static_cast<unsigned short>(0x80F7 | (reg1 << 8)) });
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::ShiftLeft:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											ProgramData.push_back(0x80 | (reg1 & 0xF));
+											ProgramData.push_back((reg2 << 4) | 0xE);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentExtension != ExtensionType::HyperCHIP64 && (CurrentExtension == ExtensionType::XOCHIP || CurrentOptimization != OptimizationType::Size))
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Random:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg = 0x0;
+										if (!ProcessRegisterOperand(0, reg))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::ImmediateValue)
+										{
+											unsigned char value = Process8BitImmediateValueOperand(1);
+											if (error)
+											{
+												break;
+											}
+											ProgramData.push_back(0xC0 | (reg & 0xF));
+											ProgramData.push_back(value);
+											current_address += 2;
+											if (current_address > 0xFFF && CurrentExtension != ExtensionType::HyperCHIP64 && (CurrentExtension == ExtensionType::XOCHIP || CurrentOptimization != OptimizationType::Size))
+											{
+												error = true;
+												error_type = ErrorType::Only4KBSupported;
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Draw:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg1 = 0x0;
+										if (!ProcessRegisterOperand(0, reg1))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										if (current_instruction.OperandList[1].Type == OperandType::Register)
+										{
+											unsigned char reg2 = 0x0;
+											if (!ProcessRegisterOperand(1, reg2))
+											{
+												error = true;
+												error_type = ErrorType::InvalidRegister;
+												break;
+											}
+											if (current_instruction.OperandList[2].Type == OperandType::ImmediateValue)
+											{
+												unsigned char height = Process8BitImmediateValueOperand(2);
+												if (error)
+												{
+													break;
+												}
+												ProgramData.push_back(0xD0 | (reg1 & 0xF));
+												ProgramData.push_back((reg2 << 4) | (height & 0xF));
+												current_address += 2;
+												if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+												{
+													error = true;
+													error_type = ErrorType::Only4KBSupported;
+												}
+												break;
+											}
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::SkipKeyPressed:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg = 0x0;
+										if (!ProcessRegisterOperand(0, reg))
+										{
+											break;
+										}
+										ProgramData.push_back(0xE0 | (reg & 0xF));
+										ProgramData.push_back(0x9E);
+										current_address += 2;
+										if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+										{
+											error = true;
+											error_type = ErrorType::Only4KBSupported;
+											break;
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::SkipKeyNotPressed:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg = 0x0;
+										if (!ProcessRegisterOperand(0, reg))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										ProgramData.push_back(0xE0 | (reg & 0xF));
+										ProgramData.push_back(0xA1);
+										current_address += 2;
+										if (current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+										{
+											error = true;
+											error_type = ErrorType::Only4KBSupported;
+											break;
+										}
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Volume:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::Register:
+									{
+										unsigned char reg = 0x0;
+										if (!ProcessRegisterOperand(0, reg))
+										{
+											error = true;
+											error_type = ErrorType::InvalidRegister;
+											break;
+										}
+										ProgramData.push_back(0xF0 | (reg & 0xF));
+										ProgramData.push_back(0x3B);
+										current_address += 2;
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Voice:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::ImmediateValue:
+									{
+										unsigned char value = Process8BitImmediateValueOperand(0);
+										if (error)
+										{
+											break;
+										}
+										ProgramData.push_back(0xF0 | (value & 0xF));
+										ProgramData.push_back(0x3C);
+										current_address += 2;
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Channel:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								switch (current_instruction.OperandList[0].Type)
+								{
+									case OperandType::None:
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+									case OperandType::ImmediateValue:
+									{
+										unsigned char value = Process8BitImmediateValueOperand(0);
+										if (error)
+										{
+											break;
+										}
+										ProgramData.push_back(0xF0 | (value & 0xF));
+										ProgramData.push_back(0x3D);
+										current_address += 2;
+										break;
+									}
+								}
+								break;
+							}
+							case InstructionType::Multiply:
+							case InstructionType::Divide:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								unsigned char reg = 0x0;
+								if (current_instruction.OperandList[0].Type != OperandType::Register || !ProcessRegisterOperand(0, reg) || reg == 0xF)
+								{
+									error = true;
+									error_type = ErrorType::InvalidRegister;
+									break;
+								}
+								if (current_instruction.OperandList[1].Type != OperandType::ImmediateValue)
+								{
+									error = true;
+									error_type = ErrorType::InvalidValue;
+									break;
+								}
+								unsigned char value = Process8BitImmediateValueOperand(1);
+								if (error)
+								{
+									break;
+								}
+								if (current_instruction.Type == InstructionType::Divide && value == 0)
+								{
+									error = true;
+									error_type = ErrorType::InvalidValue;
+									break;
+								}
+								unsigned char scratch = 0x0;
+								if (current_instruction.OperandList.size() == 3)
+								{
+									if (current_instruction.OperandList[2].Type != OperandType::Register || !ProcessRegisterOperand(2, scratch) || scratch == 0xF || scratch == reg)
+									{
+										error = true;
+										error_type = ErrorType::InvalidRegister;
+										break;
+									}
+								}
+								else if (value != 0 && (value & (value - 1)) != 0)
+								{
+									error = true;
+									error_type = ErrorType::ScratchRegisterRequired;
+									break;
+								}
+								ProcessExpansion((current_instruction.Type == InstructionType::Multiply) ? GetMultiplyList(reg, scratch, value) : GetDivideList(reg, scratch, value));
+								break;
+							}
+							case InstructionType::MemoryCopy:
+							case InstructionType::MemorySet:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								bool copy = (current_instruction.Type == InstructionType::MemoryCopy);
+								bool increment = (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11);
+								bool labelled = (current_instruction.OperandList[0].Type == OperandType::Label || (copy && current_instruction.OperandList[1].Type == OperandType::Label));
+								unsigned char maximum_register = (labelled && (copy || !increment)) ? 0xE : 0xF;
+								unsigned char last_register = maximum_register;
+								if (current_instruction.OperandList.size() == 4)
+								{
+									last_register = 0x0;
+									if (current_instruction.OperandList[3].Type != OperandType::Register || !ProcessRegisterOperand(3, last_register) || last_register > maximum_register)
+									{
+										error = true;
+										error_type = ErrorType::InvalidRegister;
+										break;
+									}
+								}
+								if ((current_instruction.OperandList[0].Type != OperandType::Label && current_instruction.OperandList[0].Type != OperandType::ImmediateValue) || (copy && current_instruction.OperandList[1].Type != OperandType::Label && current_instruction.OperandList[1].Type != OperandType::ImmediateValue) || (!copy && current_instruction.OperandList[1].Type != OperandType::ImmediateValue) || current_instruction.OperandList[2].Type != OperandType::ImmediateValue)
+								{
+									error = true;
+									error_type = ErrorType::InvalidValue;
+									break;
+								}
+								size_t length = Process16BitImmediateValueOperand(2);
+								unsigned char value = copy ? 0x00 : Process8BitImmediateValueOperand(1);
+								if (error || length == 0)
+								{
+									break;
+								}
+								if (FollowsSkip())
+								{
+									error = true;
+									error_type = ErrorType::ExpansionAfterSkip;
+									break;
+								}
+								std::vector<std::string> AddressNameList = { current_instruction.OperandList[0].Data, current_instruction.OperandList[1].Data };
+								auto LoadAddress = [this, &error, &error_type, &current_instruction, &AddressNameList, &ProcessLabelOperand, &Process16BitImmediateValueOperand, &ProcessExpandedOpcode](unsigned char operand, size_t offset)
+								{
+									size_t location = ProgramData.size();
+									if (current_instruction.OperandList[operand].Type == OperandType::Label)
+									{
+										current_instruction.OperandList[operand].Data = AddressNameList[operand];
+										ProcessLabelOperand(operand, 0xA);
+									}
+									else
+									{
+										size_t address = Process16BitImmediateValueOperand(operand) + offset;
+										offset = 0;
+										if (address <= 0xFFF)
+										{
+											ProgramData.push_back(0xA0 | ((address & 0xF00) >> 8));
+											ProgramData.push_back(address & 0xFF);
+											current_address += 2;
+										}
+										else if ((CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64) && address <= 0xFFFF)
+										{
+											ProgramData.push_back(0xF0);
+											ProgramData.push_back(0x00);
+											ProgramData.push_back(address >> 8);
+											ProgramData.push_back(address & 0xFF);
+											current_address += 4;
+										}
+										else
+										{
+											error = true;
+											error_type = ErrorType::Only4KBSupported;
+										}
+									}
+									if (error)
+									{
+										return;
+									}
+									InstructionLocationList.push_back({ location, ProgramData.size() - location, current_line_number });
+									while (offset > 0)
+									{
+										size_t step = std::min<size_t>(offset, 0xFF);
+										ProcessExpandedOpcode(0x6F00 | step);
+										ProcessExpandedOpcode(0xFF1E);
+										offset -= step;
+									}
+								};
+								size_t batch_size = last_register + 1;
+								if (copy)
+								{
+									for (size_t o = 0; o < length && !error; o += batch_size)
+									{
+										unsigned short reg = std::min(batch_size, length - o) - 1;
+										LoadAddress(1, o);
+										if (error)
+										{
+											break;
+										}
+										ProcessExpandedOpcode(0xF065 | (reg << 8));
+										LoadAddress(0, o);
+										if (error)
+										{
+											break;
+										}
+										ProcessExpandedOpcode(0xF055 | (reg << 8));
+									}
+								}
+								else
+								{
+									for (size_t r = 0; r < std::min(batch_size, length); ++r)
+									{
+										ProcessExpandedOpcode(0x6000 | (r << 8) | value);
+									}
+									LoadAddress(0, 0);
+									for (size_t o = 0; o < length && !error; o += batch_size)
+									{
+										if (o > 0 && !increment)
+										{
+											if (current_instruction.OperandList[0].Type == OperandType::ImmediateValue)
+											{
+												LoadAddress(0, o);
+											}
+											else
+											{
+												ProcessExpandedOpcode(0x6F00 | batch_size);
+												ProcessExpandedOpcode(0xFF1E);
+											}
+										}
+										ProcessExpandedOpcode(0xF055 | ((std::min(batch_size, length - o) - 1) << 8));
+									}
+								}
+								if (!error && current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+								}
+								break;
+							}
+							case InstructionType::Switch:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								unsigned char reg = 0x0;
+								if (current_instruction.OperandList[0].Type != OperandType::Register || !ProcessRegisterOperand(0, reg))
+								{
+									error = true;
+									error_type = ErrorType::InvalidRegister;
+									break;
+								}
+								size_t case_count = current_instruction.OperandList.size() - 1;
+								for (size_t c = 1; c <= case_count; ++c)
+								{
+									if (current_instruction.OperandList[c].Type != OperandType::Label)
+									{
+										error = true;
+										error_type = ErrorType::InvalidValue;
+										break;
+									}
+								}
+								if (error)
+								{
+									break;
+								}
+								if (case_count > 1 && FollowsSkip())
+								{
+									error = true;
+									error_type = ErrorType::ExpansionAfterSkip;
+									break;
+								}
+								auto ProcessCase = [this, &ProcessLabelOperand](unsigned char operand, unsigned char opcode)
+								{
+									size_t location = ProgramData.size();
+									ProcessLabelOperand(operand, opcode);
+									if (ProgramData.size() > location)
+									{
+										InstructionLocationList.push_back({ location, ProgramData.size() - location, current_line_number });
+									}
+								};
+								bool indirect = (CurrentExtension == ExtensionType::HyperCHIP64);
+								bool chained = (CurrentExtension == ExtensionType::SuperCHIP10 || CurrentExtension == ExtensionType::SuperCHIP11);
+								if (chained || case_count <= (indirect ? 2 : 3))
+								{
+									for (size_t c = 1; c < case_count && !error; ++c)
+									{
+										ProcessExpandedOpcode(0x4000 | (reg << 8) | (c - 1));
+										ProcessCase(c, 0x1);
+									}
+									if (!error)
+									{
+										ProcessCase(case_count, 0x1);
+									}
+									break;
+								}
+								std::string name = "@switch" + std::to_string(current_line_number);
+								while (SymbolIndex.find(name) != SymbolIndex.end())
+								{
+									name += '_';
+								}
+								current_instruction.OperandList.push_back({ OperandType::Label, name });
+								if (indirect)
+								{
+									ProcessCase(current_instruction.OperandList.size() - 1, 0xA);
+									if (error)
+									{
+										break;
+									}
+									ProcessExpandedOpcode(0xF01E | (reg << 8));
+									ProcessExpandedOpcode(0xF020 | (reg << 8));
+								}
+								else
+								{
+									if (reg != 0x0)
+									{
+										ProcessExpandedOpcode(0x8000 | (reg << 4));
+									}
+									ProcessExpandedOpcode(0x8004);
+									ProcessCase(current_instruction.OperandList.size() - 1, 0xB);
+									if (error)
+									{
+										break;
+									}
+								}
+								SymbolIndex.emplace(name, SymbolTable.size());
+								SymbolTable.push_back({ name, SymbolType::Label, current_address });
+								for (size_t c = 1; c <= case_count && !error; ++c)
+								{
+									if (!indirect)
+									{
+										ProcessCase(c, 0x1);
+										continue;
+									}
+									unsigned short reference_address = static_cast<unsigned short>(current_address - 0x200);
+									unsigned short value = 0;
+									auto symbol = SymbolIndex.find(current_instruction.OperandList[c].Data);
+									if (symbol != SymbolIndex.end())
+									{
+										value = SymbolTable[symbol->second].Location;
+										LabelReferenceList.push_back({ current_instruction.OperandList[c].Data, current_line_number, reference_address, false, false });
+									}
+									else
+									{
+										UnresolvedReferenceList.push_back({ current_instruction.OperandList[c].Data, current_line_number, reference_address, false, false });
+										LabelReferenceList.push_back(UnresolvedReferenceList.back());
+									}
+									ProgramData.push_back(value >> 8);
+									ProgramData.push_back(value & 0xFF);
+									current_address += 2;
+								}
+								if (!error && current_address > 0xFFF && CurrentOptimization != OptimizationType::Size && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+								{
+									error = true;
+									error_type = ErrorType::Only4KBSupported;
+								}
+								break;
+							}
+							case InstructionType::AssertCycles:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								if (current_instruction.OperandList[0].Type != OperandType::Label || current_instruction.OperandList[1].Type != OperandType::ImmediateValue)
+								{
+									error = true;
+									error_type = ErrorType::InvalidValue;
+									break;
+								}
+								unsigned short maximum = Process16BitImmediateValueOperand(1);
+								if (!error)
+								{
+									CycleAssertionList.push_back({ current_instruction.OperandList[0].Data, maximum, current_line_number });
+								}
+								break;
+							}
+							case InstructionType::InitBegin:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								if (init_region)
+								{
+									error = true;
+									error_type = ErrorType::UnmatchedInitRegion;
+									break;
+								}
+								InitList.push_back({ ProgramData.size(), 0, current_line_number });
+								init_region = true;
+								break;
+							}
+							case InstructionType::InitEnd:
+							{
+								if (current_instruction.OperandList.size() > 0)
+								{
+									error = true;
+									error_type = ErrorType::NoOperandsSupported;
+									break;
+								}
+								if (!init_region)
+								{
+									error = true;
+									error_type = ErrorType::UnmatchedInitRegion;
+									break;
+								}
+								InitList.back().Size = ProgramData.size() - InitList.back().Offset;
+								init_region = false;
+								break;
+							}
+							case InstructionType::Add16:
+							{
+								if (!OperandCountCheck())
+								{
+									break;
+								}
+								unsigned char reg1 = 0x0;
+								unsigned char reg2 = 0x0;
+								if (current_instruction.OperandList[0].Type != OperandType::Register || current_instruction.OperandList[1].Type != OperandType::Register || !ProcessRegisterOperand(0, reg1) || !ProcessRegisterOperand(1, reg2) || reg1 == 0xF || reg2 == 0xF || reg1 == reg2)
+								{
+									error = true;
+									error_type = ErrorType::InvalidRegister;
+									break;
+								}
+								if (current_instruction.OperandList[2].Type != OperandType::ImmediateValue)
+								{
+									error = true;
+									error_type = ErrorType::InvalidValue;
+									break;
+								}
+								unsigned short value = Process16BitImmediateValueOperand(2);
+								if (error)
+								{
+									break;
+								}
+								std::vector<unsigned short> OpcodeList;
+								if ((value & 0xFF) != 0)
+								{
+									OpcodeList.push_back(0x6F00 | (value & 0xFF));
+									OpcodeList.push_back(0x80F4 | (reg2 << 8));
+									OpcodeList.push_back(0x80F4 | (reg1 << 8));
+								}
+								if ((value >> 8) != 0)
+								{
+									OpcodeList.push_back(0x7000 | (reg1 << 8) | (value >> 8));
+								}
+								ProcessExpansion(OpcodeList);
+								break;
+							}
+						}
+						if (!error && ProgramData.size() > instruction_offset && (InstructionLocationList.size() == 0 || InstructionLocationList.back().Offset < instruction_offset))
+						{
+							InstructionLocationList.push_back({ instruction_offset, ProgramData.size() - instruction_offset, current_line_number });
+						}
+						if (!error && relocatable && ProgramData.size() > instruction_offset)
+						{
+							error = true;
+							error_type = ErrorType::CodeInRelocatableData;
+						}
+					}
+					break;
+				}
+				default:
+				{
+					if (!comment)
+					{
+						if (token.size() == 0)
+						{
+							switch (token_type)
+							{
+								case TokenType::Instruction:
+								{
+									if (isdigit(static_cast<unsigned char>(line_data[i])))
+									{
+										current_operand.Type = OperandType::ImmediateValue;
+									}
+									else if (isspace(static_cast<unsigned char>(line_data[i])))
+									{
+										break;
+									}
+									token += line_data[i];
+									break;
+								}
+								case TokenType::Origin:
+								{
+									if (isspace(static_cast<unsigned char>(line_data[i])))
+									{
+										break;
+									}
+									token += line_data[i];
+									break;
+								}
+								case TokenType::DataByte:
+								{
+									if (!string_mode)
+									{
+										if (isspace(static_cast<unsigned char>(line_data[i])))
+										{
+											break;
+										}
+										token += line_data[i];
+									}
+									else
+									{
+										ProcessStringDataByte(line_data[i]);
+										if (escape_mode)
+										{
+											escape_mode = false;
+										}
+									}
+									break;
+								}
+								case TokenType::DataWord:
+								{
+									if (!string_mode)
+									{
+										if (isspace(static_cast<unsigned char>(line_data[i])))
+										{
+											break;
+										}
+										token += line_data[i];
+									}
+									break;
+								}
+								default:
+								{
+									if (isdigit(static_cast<unsigned char>(line_data[i])))
+									{
+										error = true;
+										break;
+									}
+									else if (isspace(static_cast<unsigned char>(line_data[i])))
+									{
+										break;
+									}
+									token += line_data[i];
+									break;
+								}
+							}
+						}
+						else
+						{
+							if (!pointer_mode || (current_operand.Type == OperandType::Pointer && pointer_mode))
+							{
+								token += line_data[i];
+							}
+							else
+							{
+								error = true;
+							}
+						}
+					}
+					break;
+				}
+			}
+			if (error)
+			{
+				++error_count;
+				std::ostringstream error_message;
+				size_t error_column = i - token.size();
+				switch (error_type)
+				{
+					case ErrorType::ReservedToken:
+					{
+						error_message << "Reserved Token '" << u_token << "'\n";
+						break;
+					}
+					case ErrorType::InvalidToken:
+					{
+						error_message << "Invalid Token '" << token << "'\n";
+						break;
+					}
+					case ErrorType::NoOperandsSupported:
+					{
+						switch (current_instruction.Type)
+						{
+							case InstructionType::ClearScreen:
+							{
+								error_message << "CLS";
+								break;
+							}
+							case InstructionType::Return:
+							{
+								error_message << "RET";
+								break;
+							}
+							case InstructionType::ScrollRight:
+							{
+								error_message << "SCR";
+								break;
+							}
+							case InstructionType::ScrollLeft:
+							{
+								error_message << "SCL";
+								break;
+							}
+							case InstructionType::Exit:
+							{
+								error_message << "EXIT";
+								break;
+							}
+							case InstructionType::InitBegin:
+							{
+								error_message << "INIT_BEGIN";
+								break;
+							}
+							case InstructionType::InitEnd:
+							{
+								error_message << "INIT_END";
+								break;
+							}
+							case InstructionType::Low:
+							{
+								error_message << "LOW";
+								break;
+							}
+							case InstructionType::High:
+							{
+								error_message << "HIGH";
+								break;
+							}
+							case InstructionType::Audio:
+							{
+								error_message << "AUDIO";
+								break;
+							}
+						}
+						error_message << " does not support operands.\n";
+						break;
+					}
+					case ErrorType::TooFewOperands:
+					{
+						switch (current_instruction.Type)
+						{
+							case InstructionType::ScrollDown:
+							{
+								error_message << "SCD";
+								break;
+							}
+							case InstructionType::ScrollUp:
+							{
+								error_message << "SCU";
+								break;
+							}
+							case InstructionType::Jump:
+							{
+								error_message << "JP";
+								break;
+							}
+							case InstructionType::Call:
+							{
+								error_message << "CALL";
+								break;
+							}
+							case InstructionType::SkipEqual:
+							{
+								error_message << "SE";
+								break;
+							}
+							case InstructionType::SkipNotEqual:
+							{
+								error_message << "SNE";
+								break;
+							}
+							case InstructionType::Load:
+							{
+								error_message << "LD";
+								break;
+							}
+							case InstructionType::Add:
+							{
+								error_message << "ADD";
+								break;
+							}
+							case InstructionType::Or:
+							{
+								error_message << "OR";
+								break;
+							}
+							case InstructionType::And:
+							{
+								error_message << "AND";
+								break;
+							}
+							case InstructionType::Xor:
+							{
+								error_message << "XOR";
+								break;
+							}
+							case InstructionType::Subtract:
+							{
+								error_message << "SUB";
+								break;
+							}
+							case InstructionType::ShiftRight:
+							{
+								error_message << "SHR";
+								break;
+							}
+							case InstructionType::SubtractN:
+							{
+								error_message << "SUBN";
+								break;
+							}
+							case InstructionType::Plane:
+							{
+								error_message << "PLANE";
+								break;
+							}
+							case InstructionType::Pitch:
+							{
+								error_message << "PITCH";
+								break;
+							}
+							case InstructionType::RotateRight:
+							{
+								error_message << "ROR";
+								break;
+							}
+							case InstructionType::RotateLeft:
+							{
+								error_message << "ROL";
+								break;
+							}
+							case InstructionType::Test:
+							{
+								error_message << "TEST";
+								break;
+							}
+							case InstructionType::Not:
+							{
+								error_message << "NOT";
+								break;
+							}
+							case InstructionType::ShiftLeft:
+							{
+								error_message << "SHL";
+								break;
+							}
+							case InstructionType::Random:
+							{
+								error_message << "RND";
+								break;
+							}
+							case InstructionType::Draw:
+							{
+								error_message << "DRW";
+								break;
+							}
+							case InstructionType::SkipKeyPressed:
+							{
+								error_message << "SKP";
+								break;
+							}
+							case InstructionType::SkipKeyNotPressed:
+							{
+								error_message << "SKNP";
+								break;
+							}
+							case InstructionType::Volume:
+							{
+								error_message << "VOLUME";
+								break;
+							}
+							case InstructionType::Voice:
+							{
+								error_message << "VOICE";
+								break;
+							}
+							case InstructionType::Channel:
+							{
+								error_message << "CHANNEL";
+								break;
+							}
+							case InstructionType::Multiply:
+							{
+								error_message << "MUL";
+								break;
+							}
+							case InstructionType::Divide:
+							{
+								error_message << "DIV";
+								break;
+							}
+							case InstructionType::Add16:
+							{
+								error_message << "ADD16";
+								break;
+							}
+							case InstructionType::MemoryCopy:
+							{
+								error_message << "MEMCPY";
+								break;
+							}
+							case InstructionType::MemorySet:
+							{
+								error_message << "MEMSET";
+								break;
+							}
+							case InstructionType::Switch:
+							{
+								error_message << "SWITCH";
+								break;
+							}
+							case InstructionType::AssertCycles:
+							{
+								error_message << "ASSERT_CYCLES";
+								break;
+							}
+						}
+						error_message << " only has " << current_instruction.OperandList.size() << " operands (needs at least " << current_instruction.OperandMinimum << ").\n";
+						break;
+					}
+					case ErrorType::TooManyOperands:
+					{
+						switch (current_instruction.Type)
+						{
+							case InstructionType::ScrollDown:
+							{
+								error_message << "SCD";
+								break;
+							}
+							case InstructionType::ScrollUp:
+							{
+								error_message << "SCU";
+								break;
+							}
+							case InstructionType::Jump:
+							{
+								error_message << "JP";
+								break;
+							}
+							case InstructionType::Call:
+							{
+								error_message << "CALL";
+								break;
+							}
+							case InstructionType::SkipEqual:
+							{
+								error_message << "SE";
+								break;
+							}
+							case InstructionType::SkipNotEqual:
+							{
+								error_message << "SNE";
+								break;
+							}
+							case InstructionType::Load:
+							{
+								error_message << "LD";
+								break;
+							}
+							case InstructionType::Add:
+							{
+								error_message << "ADD";
+								break;
+							}
+							case InstructionType::Or:
+							{
+								error_message << "OR";
+								break;
+							}
+							case InstructionType::And:
+							{
+								error_message << "AND";
+								break;
+							}
+							case InstructionType::Xor:
+							{
+								error_message << "XOR";
+								break;
+							}
+							case InstructionType::Subtract:
+							{
+								error_message << "SUB";
+								break;
+							}
+							case InstructionType::ShiftRight:
+							{
+								error_message << "SHR";
+								break;
+							}
+							case InstructionType::SubtractN:
+							{
+								error_message << "SUBN";
+								break;
+							}
+							case InstructionType::Plane:
+							{
+								error_message << "PLANE";
+								break;
+							}
+							case InstructionType::Pitch:
+							{
+								error_message << "PITCH";
+								break;
+							}
+							case InstructionType::RotateRight:
+							{
+								error_message << "ROR";
+								break;
+							}
+							case InstructionType::RotateLeft:
+							{
+								error_message << "ROL";
+								break;
+							}
+							case InstructionType::Test:
+							{
+								error_message << "TEST";
+								break;
+							}
+							case InstructionType::Not:
+							{
+								error_message << "NOT";
+								break;
+							}
+							case InstructionType::ShiftLeft:
+							{
+								error_message << "SHL";
+								break;
+							}
+							case InstructionType::Random:
+							{
+								error_message << "RND";
+								break;
+							}
+							case InstructionType::Draw:
+							{
+								error_message << "DRW";
+								break;
+							}
+							case InstructionType::SkipKeyPressed:
+							{
+								error_message << "SKP";
+								break;
+							}
+							case InstructionType::SkipKeyNotPressed:
+							{
+								error_message << "SKNP";
+								break;
+							}
+							case InstructionType::Volume:
+							{
+								error_message << "VOLUME";
+								break;
+							}
+							case InstructionType::Voice:
+							{
+								error_message << "VOICE";
+								break;
+							}
+							case InstructionType::Channel:
+							{
+								error_message << "CHANNEL";
+								break;
+							}
+							case InstructionType::Multiply:
+							{
+								error_message << "MUL";
+								break;
+							}
+							case InstructionType::Divide:
+							{
+								error_message << "DIV";
+								break;
+							}
+							case InstructionType::Add16:
+							{
+								error_message << "ADD16";
+								break;
+							}
+							case InstructionType::MemoryCopy:
+							{
+								error_message << "MEMCPY";
+								break;
+							}
+							case InstructionType::MemorySet:
+							{
+								error_message << "MEMSET";
+								break;
+							}
+							case InstructionType::Switch:
+							{
+								error_message << "SWITCH";
+								break;
+							}
+							case InstructionType::AssertCycles:
+							{
+								error_message << "ASSERT_CYCLES";
+								break;
+							}
+						}
+						error_message << " has too many operands (" << current_instruction.OperandList.size() << ", supports up to " << current_instruction.OperandMaximum << ").\n";
+						break;
+					}
+					case ErrorType::InvalidValue:
+					{
+						error_message << "Invalid Value\n";
+						break;
+					}
+					case ErrorType::InvalidRegister:
+					{
+						error_message << "Invalid Register\n";
+						break;
+					}
+					case ErrorType::ReservedAddress:
+					{
+						error_message << "Addresses 0x000-0x1FF are reserved.\n";
+						break;
+					}
+					case ErrorType::BelowCurrentAddress:
+					{
+						error_message << "Attempting to the set the address below the current address.\n";
+						break;
+					}
+					case ErrorType::Only4KBSupported:
+					{
+						error_message << "Current extension only supports up to 4KB (maxed at 0xFFF).\n";
+						break;
+					}
+					case ErrorType::ScratchRegisterRequired:
+					{
+						error_message << "This value needs a scratch register as the last operand.\n";
+						break;
+					}
+					case ErrorType::CodeInRelocatableData:
+					{
+						error_message << "Instructions cannot be placed between RELOCATABLE ON and RELOCATABLE OFF.\n";
+						break;
+					}
+					case ErrorType::UnmatchedInitRegion:
+					{
+						error_message << "INIT_BEGIN and INIT_END must come in pairs, with no ORG in between.\n";
+						break;
+					}
+					case ErrorType::ExpansionAfterSkip:
+					{
+						error_message << "Instruction expands to several instructions, so it cannot follow a skip.\n";
+						break;
+					}
+					case ErrorType::SuperCHIP10Required:
+					{
+						switch (current_instruction.Type)
+						{
+							case InstructionType::Exit:
+							{
+								error_message << "EXIT";
+								break;
+							}
+							case InstructionType::Low:
+							{
+								error_message << "LOW";
+								break;
+							}
+							case InstructionType::High:
+							{
+								error_message << "HIGH";
+								break;
+							}
+							case InstructionType::Load:
+							{
+								error_message << "LD ";
+								if (current_instruction.OperandList.size() == 2)
+								{
+									switch (current_instruction.OperandList[0].Type)
+									{
+										case OperandType::UserRPL:
+										{
+											error_message << "R, VX";
+											break;
+										}
+										case OperandType::Register:
+										{
+											if (current_instruction.OperandList[1].Type == OperandType::UserRPL)
+											{
+												error_message << "VX, R";
+											}
+											break;
+										}
+									}
+								}
+								break;
+							}
+						}
+						error_message << " instruction requires using at least the SuperCHIP V1.0 extension to use.\n";
+						break;
+					}
+					case ErrorType::SuperCHIP11Required:
+					{
+						switch (current_instruction.Type)
+						{
+							case InstructionType::ScrollDown:
+							{
+								error_message << "SCD";
+								break;
+							}
+							case InstructionType::ScrollRight:
+							{
+								error_message << "SCR";
+								break;
+							}
+							case InstructionType::ScrollLeft:
+							{
+								error_message << "SCL";
+								break;
+							}
+							case InstructionType::Load:
+							{
+								error_message << "LD ";
+								if (current_instruction.OperandList.size() == 2)
+								{
+									if (current_instruction.OperandList[0].Type == OperandType::HiResFont)
+									{
+										error_message << "HF, VX";
+									}
+								}
+								break;
+							}
+						}
+						error_message << " instruction requires using at least the SuperCHIP V1.1 extension to use.\n";
+						break;
+					}
+					case ErrorType::XOCHIPRequired:
+					{
+						switch (current_instruction.Type)
+						{
+							case InstructionType::ScrollUp:
+							{
+								error_message << "SCU";
+								break;
+							}
+							case InstructionType::Load:
+							{
+								if (current_instruction.OperandList.size() >= 2 && current_instruction.OperandList.size() <= 3)
+								{
+									error_message << "LD ";
+									switch (current_instruction.OperandList[0].Type)
+									{
+										case OperandType::Register:
+										{
+											if (current_instruction.OperandList[1].Type == OperandType::Register)
+											{
+												if (current_instruction.OperandList[2].Type == OperandType::Pointer)
+												{
+													error_message << "VX, VY, [I]";
+												}
+											}
+											break;
+										}
+										case OperandType::Pointer:
+										{
+											if (current_instruction.OperandList[1].Type == OperandType::Register)
+											{
+												if (current_instruction.OperandList[2].Type == OperandType::Register)
+												{
+													error_message << "[I], VX, VY";
+												}
+											}
+											break;
+										}
+									}
+								}
+								break;
+							}
+							case InstructionType::Plane:
+							{
+								error_message << "PLANE";
+								break;
+							}
+							case InstructionType::Audio:
+							{
+								error_message << "AUDIO";
+								break;
+							}
+							case InstructionType::Pitch:
+							{
+								error_message << "PITCH";
+								break;
+							}
+						}
+						error_message << " requires using at least the XO-CHIP extension to use.\n";
+						break;
+					}
+					case ErrorType::HyperCHIP64Required:
+					{
+						switch (current_instruction.Type)
+						{
+							case InstructionType::Test:
+							{
+								error_message << "TEST";
+								break;
+							}
+							case InstructionType::Jump:
+							{
+								error_message << "JP ";
+								if (current_instruction.OperandList.size() == 1)
+								{
+									if (current_instruction.OperandList[0].Type == OperandType::Pointer)
+									{
+										error_message << "[I + VX]";
+									}
+								}
+								break;
+							}
+							case InstructionType::Call:
+							{
+								error_message << "CALL ";
+								if (current_instruction.OperandList.size() == 1)
+								{
+									if (current_instruction.OperandList[0].Type == OperandType::Pointer)
+									{
+										error_message << "[I + VX]";
+									}
+								}
+								break;
+							}
+							case InstructionType::Load:
+							{
+								if (current_instruction.OperandList.size() >= 2 && current_instruction.OperandList.size() <= 3)
+								{
+									error_message << "LD ";
+									switch (current_instruction.OperandList[0].Type)
+									{
+										case OperandType::AddressRegister:
+										{
+											if (current_instruction.OperandList[1].Type == OperandType::Pointer)
+											{
+												error_message << "I, [I + VX]";
+											}
+											break;
+										}
+									}
+								}
+								break;
+							}
+							case InstructionType::Volume:
+							{
+								error_message << "VOLUME";
+								break;
+							}
+							case InstructionType::Voice:
+							{
+								error_message << "VOICE";
+								break;
+							}
+							case InstructionType::Channel:
+							{
+								error_message << "CHANNEL";
+								break;
+							}
+						}
+						error_message << " instruction requires using at least the HyperCHIP-64 extension to use.\n";
+						break;
+					}
+					case ErrorType::BinaryFileDoesNotExist:
+					{
+						error_message << '\'' << token << "' does not exist.\n";
+						break;
+					}
+					default:
+					{
+						error_message << "Unknown Error\n";
+						break;
+					}
+				}
+				Log << "Error at " << current_line_number << ':' << error_column << " : " << error_message.str();
+				DiagnosticList.push_back({ current_line_number, error_column, error_message.str() });
+				break;
+			}
+		}
+		++current_line_number;
+	}
+	if (relocatable)
+	{
+		RelocatableList.back().Size = ProgramData.size() - RelocatableList.back().Offset;
+		relocatable = false;
+	}
+	if (init_region)
+	{
+		++error_count;
+		Log << "Error at " << InitList.back().LineNumber << " : INIT_BEGIN has no matching INIT_END.\n";
+		DiagnosticList.push_back({ InitList.back().LineNumber, 0, "INIT_BEGIN has no matching INIT_END.\n" });
+		init_region = false;
+	}
+	if (error_count == 0 && RelocatableList.size() > 0 && !object_mode && (CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64))
+	{
+		PlaceRelocatableData();
+	}
+	if (error_count == 0 && ProfileIndex.size() > 0 && !object_mode)
+	{
+		ArrangeByProfile();
+	}
+	if (error_count == 0)
+	{
+		RelaxReferences();
+	}
+	if (error_count == 0 && CurrentOptimization == OptimizationType::Size && !object_mode)
+	{
+		OutlineSequences();
+	}
+	if (error_count == 0 && CurrentOptimization == OptimizationType::Speed && !object_mode)
+	{
+		InlineSubroutines();
+	}
+	if (CurrentOptimization == OptimizationType::Size && 0x200 + ProgramData.size() > 0x1000 && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+	{
+		++error_count;
+		Log << "Error : Program is " << ProgramData.size() << " bytes after size optimization, which exceeds the 4KB supported by the current extension (maxed at 0xFFF).\n";
+		DiagnosticList.push_back({ current_line_number, 0, "Program exceeds the 4KB supported by the current extension after size optimization.\n" });
+	}
+	ResolveReferences();
+	for (auto &u : UnresolvedReferenceList)
+	{
+		bool resolved = (SymbolIndex.find(u.Name) != SymbolIndex.end());
+		if (!resolved && !object_mode)
+		{
+			++error_count;
+			Log << "Unresolved reference '" << u.Name << "' at line " << u.LineNumber << ".\n";
+			DiagnosticList.push_back({ u.LineNumber, 0, "Unresolved reference '" + u.Name + "'\n" });
+		}
+	}
+	if (error_count == 0 && prune && !object_mode)
+	{
+		PruneUnreachable();
+	}
+	if (error_count == 0 && deduplicate)
+	{
+		DeduplicateData();
+	}
+	if (error_count == 0 && CurrentOptimization != OptimizationType::None)
+	{
+		Optimize();
+	}
+	if (error_count == 0 && InitList.size() > 0 && !object_mode)
+	{
+		EvaluateInitRegions();
+	}
+	if (error_count == 0)
+	{
+		CheckCycleAssertions();
+	}
+	return error_count == 0;
+}
+
+void BandCHIP_Assembler::Assembler::ResolveReferences()
+{
+	for (auto &r : LabelReferenceList)
+	{
+		auto symbol = SymbolIndex.find(r.Name);
+		if (symbol != SymbolIndex.end())
+		{
+			size_t location = SymbolTable[symbol->second].Location;
+			if (r.Address + static_cast<size_t>(r.LongAddress ? 4 : 2) > ProgramData.size())
+			{
+				continue;
+			}
+			if (location > 0xFFF && r.IsInstruction && !r.LongAddress)
+			{
+				++error_count;
+				Log << "Error at " << r.LineNumber << " : Reference to '" << r.Name << "' at 0x" << std::hex << std::uppercase << location << std::dec << std::nouppercase << " does not fit in 12 bits.\n";
+				DiagnosticList.push_back({ r.LineNumber, 0, "Reference to '" + r.Name + "' does not fit in 12 bits.\n" });
+				continue;
+			}
+			if (location > 0xFFF && !r.IsInstruction && CurrentExtension != ExtensionType::XOCHIP && CurrentExtension != ExtensionType::HyperCHIP64)
+			{
+				++error_count;
+				Log << "Error at " << r.LineNumber << " : Reference to '" << r.Name << "' at 0x" << std::hex << std::uppercase << location << std::dec << std::nouppercase << " is beyond 4KB.\n";
+				DiagnosticList.push_back({ r.LineNumber, 0, "Reference to '" + r.Name + "' is beyond 4KB.\n" });
+				continue;
+			}
+			PatchReference(ProgramData, r, location);
+		}
+	}
+}
+
+bool BandCHIP_Assembler::Assembler::Relayout(std::vector<RelayoutData> &EditList)
+{
+	std::sort(EditList.begin(), EditList.end(), [](const RelayoutData &a, const RelayoutData &b) { return a.Offset < b.Offset; });
+	std::vector<std::pair<size_t, long>> BreakList;
+	std::vector<long> OriginDeltaList(OriginList.size(), 0);
+	long delta = 0;
+	size_t e = 0;
+	for (size_t o = 0; o <= OriginList.size(); ++o)
+	{
+		size_t segment_end = (o < OriginList.size()) ? OriginList[o].Offset : std::string::npos;
+		for (; e < EditList.size() && EditList[e].Offset < segment_end; ++e)
+		{
+			delta += static_cast<long>(EditList[e].NewData.size()) - static_cast<long>(EditList[e].OldSize);
+			BreakList.push_back({ EditList[e].Offset + EditList[e].OldSize, delta });
+		}
+		if (o < OriginList.size())
+		{
+			if (delta > static_cast<long>(OriginList[o].Offset - OriginList[o].PadOffset))
+			{
+				return false;
+			}
+			OriginDeltaList[o] = delta;
+			delta = 0;
+			BreakList.push_back({ OriginList[o].Offset, 0 });
+		}
+	}
+	auto FindEdit = [&EditList](size_t offset)
+	{
+		auto edit = std::upper_bound(EditList.begin(), EditList.end(), offset, [](size_t value, const RelayoutData &data) { return value < data.Offset; });
+		if (edit != EditList.begin() && offset < (edit - 1)->Offset + (edit - 1)->OldSize)
+		{
+			return edit - 1;
+		}
+		return EditList.end();
+	};
+	auto MapOffset = [&EditList, &BreakList, &FindEdit](size_t offset)
+	{
+		auto edit = FindEdit(offset);
+		if (edit != EditList.end())
+		{
+			offset = edit->Offset;
+		}
+		auto point = std::upper_bound(BreakList.begin(), BreakList.end(), offset, [](size_t value, const std::pair<size_t, long> &data) { return value < data.first; });
+		long offset_delta = 0;
+		if (point != BreakList.begin())
+		{
+			offset_delta = (point - 1)->second;
+		}
+		return static_cast<size_t>(static_cast<long>(offset) + offset_delta);
+	};
+	auto IsReplaced = [](const RelayoutData &edit)
+	{
+		return edit.NewData.size() == 0 || edit.NewReferenceList.size() > 0 || edit.NewInstructionList.size() > 0;
+	};
+	std::vector<unsigned char> NewProgramData;
+	NewProgramData.reserve(ProgramData.size() + std::max(delta, 0L));
+	size_t position = 0;
+	e = 0;
+	for (size_t o = 0; o <= OriginList.size(); ++o)
+	{
+		size_t pad_offset = (o < OriginList.size()) ? OriginList[o].PadOffset : ProgramData.size();
+		for (; e < EditList.size() && EditList[e].Offset < pad_offset; ++e)
+		{
+			NewProgramData.insert(NewProgramData.end(), ProgramData.begin() + position, ProgramData.begin() + EditList[e].Offset);
+			NewProgramData.insert(NewProgramData.end(), EditList[e].NewData.begin(), EditList[e].NewData.end());
+			position = EditList[e].Offset + EditList[e].OldSize;
+		}
+		NewProgramData.insert(NewProgramData.end(), ProgramData.begin() + position, ProgramData.begin() + pad_offset);
+		if (o < OriginList.size())
+		{
+			NewProgramData.resize(NewProgramData.size() + (OriginList[o].Offset - OriginList[o].PadOffset) - OriginDeltaList[o], 0x00);
+			position = OriginList[o].Offset;
+			OriginList[o].PadOffset += OriginDeltaList[o];
+		}
+	}
+	for (auto &s : SymbolTable)
+	{
+		s.Location = MapOffset(s.Location - 0x200) + 0x200;
+	}
+	std::vector<size_t> ReferenceIndexList(LabelReferenceList.size(), std::string::npos);
+	size_t reference_count = 0;
+	for (size_t r = 0; r < LabelReferenceList.size(); ++r)
+	{
+		auto edit = FindEdit(LabelReferenceList[r].Address);
+		if (edit != EditList.end() && IsReplaced(*edit))
+		{
+			continue;
+		}
+		ReferenceIndexList[r] = reference_count;
+		if (reference_count != r)
+		{
+			LabelReferenceList[reference_count] = std::move(LabelReferenceList[r]);
+		}
+		LabelReferenceList[reference_count].Address = static_cast<unsigned short>(MapOffset(LabelReferenceList[reference_count].Address));
+		++reference_count;
+	}
+	LabelReferenceList.resize(reference_count);
+	for (auto &edit : EditList)
+	{
+		for (auto &r : edit.NewReferenceList)
+		{
+			LabelReferenceList.push_back(r);
+			LabelReferenceList.back().Address = static_cast<unsigned short>(MapOffset(edit.Offset) + r.Address);
+		}
+	}
+	size_t relaxable_count = 0;
+	for (size_t r = 0; r < RelaxableReferenceList.size(); ++r)
+	{
+		if (ReferenceIndexList[RelaxableReferenceList[r]] != std::string::npos)
+		{
+			RelaxableReferenceList[relaxable_count++] = ReferenceIndexList[RelaxableReferenceList[r]];
+		}
+	}
+	RelaxableReferenceList.resize(relaxable_count);
+	UnresolvedReferenceList.erase(std::remove_if(UnresolvedReferenceList.begin(), UnresolvedReferenceList.end(), [&FindEdit, &IsReplaced, &EditList](const UnresolvedReferenceData &u)
+	{
+		auto edit = FindEdit(u.Address);
+		return edit != EditList.end() && IsReplaced(*edit);
+	}), UnresolvedReferenceList.end());
+	for (auto &u : UnresolvedReferenceList)
+	{
+		u.Address = static_cast<unsigned short>(MapOffset(u.Address));
+	}
+	InstructionLocationList.erase(std::remove_if(InstructionLocationList.begin(), InstructionLocationList.end(), [&FindEdit, &EditList](const InstructionLocationData &l)
+	{
+		auto edit = FindEdit(l.Offset);
+		return edit != EditList.end() && (edit->NewData.size() == 0 || edit->Offset != l.Offset || edit->NewInstructionList.size() > 0);
+	}), InstructionLocationList.end());
+	for (auto &l : InstructionLocationList)
+	{
+		auto edit = FindEdit(l.Offset);
+		if (edit != EditList.end())
+		{
+			l.Size = edit->NewData.size();
+		}
+		l.Offset = MapOffset(l.Offset);
+	}
+	bool instructions_added = false;
+	for (auto &edit : EditList)
+	{
+		for (auto &l : edit.NewInstructionList)
+		{
+			InstructionLocationList.push_back({ MapOffset(edit.Offset) + l.Offset, l.Size, l.LineNumber });
+			instructions_added = true;
+		}
+	}
+	if (instructions_added)
+	{
+		std::sort(InstructionLocationList.begin(), InstructionLocationList.end(), [](const InstructionLocationData &a, const InstructionLocationData &b) { return a.Offset < b.Offset; });
+	}
+	for (auto &r : InitList)
+	{
+		size_t end = MapOffset(r.Offset + r.Size);
+		r.Offset = MapOffset(r.Offset);
+		r.Size = end - r.Offset;
+	}
+	current_address = static_cast<unsigned short>(MapOffset(current_address - 0x200) + 0x200);
+	ProgramData = std::move(NewProgramData);
+	return true;
+}
+
+bool BandCHIP_Assembler::Assembler::RelaxReferences()
+{
+	if (0x200 + ProgramData.size() > 0x10000)
+	{
+		++error_count;
+		Log << "Error : Program extends past the end of memory.\n";
+		DiagnosticList.push_back({ current_line_number, 0, "Program extends past the end of memory.\n" });
+		return false;
+	}
+	while (true)
+	{
+		std::vector<RelayoutData> EditList;
+		std::vector<size_t> WidenList;
+		std::vector<size_t> PinnedOffsetList = GetPinnedOffsetList();
+		for (auto r : RelaxableReferenceList)
+		{
+			const UnresolvedReferenceData &Reference = LabelReferenceList[r];
+			auto symbol = SymbolIndex.find(Reference.Name);
+			if (!Reference.LongAddress && symbol != SymbolIndex.end() && SymbolTable[symbol->second].Location > 0xFFF)
+			{
+				if (!IsMovable(PinnedOffsetList, Reference.Address + 2))
+				{
+					++error_count;
+					Log << "Error at " << Reference.LineNumber << " : Widening 'LD I, " << Reference.Name << "' to a long load would move code that a numeric address points to.\n";
+					DiagnosticList.push_back({ Reference.LineNumber, 0, "Widening 'LD I, " + Reference.Name + "' to a long load would move code that a numeric address points to.\n" });
+					return false;
+				}
+				EditList.push_back({ Reference.Address, 2, { 0xF0, 0x00, 0x00, 0x00 } });
+				WidenList.push_back(r);
+			}
+		}
+		if (EditList.size() == 0)
+		{
+			break;
+		}
+		if (!Relayout(EditList))
+		{
+			++error_count;
+			Log << "Error at " << LabelReferenceList[WidenList[0]].LineNumber << " : Widening 'LD I, " << LabelReferenceList[WidenList[0]].Name << "' to a long load does not fit before the next ORG.\n";
+			DiagnosticList.push_back({ LabelReferenceList[WidenList[0]].LineNumber, 0, "Widening 'LD I, " + LabelReferenceList[WidenList[0]].Name + "' to a long load does not fit before the next ORG.\n" });
+			return false;
+		}
+		for (auto r : WidenList)
+		{
+			LabelReferenceList[r].LongAddress = true;
+		}
+	}
+	if (0x200 + ProgramData.size() > 0x10000)
+	{
+		++error_count;
+		Log << "Error : Widened long loads push the program past the end of memory.\n";
+		DiagnosticList.push_back({ current_line_number, 0, "Widened long loads push the program past the end of memory.\n" });
+		return false;
+	}
+	return true;
+}
+
+std::vector<size_t> BandCHIP_Assembler::Assembler::GetPinnedOffsetList() const
+{
+	std::vector<size_t> ReferenceOffsetList;
+	for (auto &r : LabelReferenceList)
+	{
+		ReferenceOffsetList.push_back(r.Address);
+	}
+	std::sort(ReferenceOffsetList.begin(), ReferenceOffsetList.end());
+	std::vector<size_t> PinnedOffsetList;
+	for (auto &l : InstructionLocationList)
+	{
+		unsigned short opcode = (ProgramData[l.Offset] << 8) | ProgramData[l.Offset + 1];
+		size_t target = (l.Size == 4) ? ((ProgramData[l.Offset + 2] << 8) | ProgramData[l.Offset + 3]) : (opcode & 0xFFF);
+		bool addressed = (l.Size == 4 && opcode == 0xF000) || (l.Size == 2 && ((opcode & 0xF000) == 0x1000 || (opcode & 0xF000) == 0x2000 || (opcode & 0xF000) == 0xA000 || (opcode & 0xF000) == 0xB000));
+		if (addressed && target >= 0x200 && target - 0x200 < ProgramData.size() && !std::binary_search(ReferenceOffsetList.begin(), ReferenceOffsetList.end(), l.Offset))
+		{
+			PinnedOffsetList.push_back(target - 0x200);
+		}
+	}
+	std::sort(PinnedOffsetList.begin(), PinnedOffsetList.end());
+	return PinnedOffsetList;
+}
+
+std::map<size_t, BandCHIP_Assembler::AccessExtentData> BandCHIP_Assembler::Assembler::GetAccessExtentList() const
+{
+	std::map<size_t, AccessExtentData> AccessExtentList;
+	bool increment = (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11);
+	size_t plane_count = (CurrentExtension == ExtensionType::HyperCHIP64) ? 4 : ((CurrentExtension == ExtensionType::XOCHIP) ? 2 : 1);
+	auto FindInstruction = [this](size_t offset)
+	{
+		auto instruction = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), offset, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+		return (instruction != InstructionLocationList.end() && instruction->Offset == offset) ? static_cast<size_t>(instruction - InstructionLocationList.begin()) : std::string::npos;
+	};
+	auto GetExtent = [this, increment, plane_count, &FindInstruction](size_t start)
+	{
+		const size_t step_limit = 0x1000;
+		AccessExtentData extent = { 0, false };
+		size_t step_count = 0;
+		std::vector<std::pair<size_t, size_t>> PendingList;
+		std::vector<std::pair<size_t, size_t>> VisitedList;
+		auto PushNext = [this, &PendingList](size_t i, size_t advance, size_t count)
+		{
+			for (size_t n = 0; n < count && i + 1 < InstructionLocationList.size() && InstructionLocationList[i + 1].Offset == InstructionLocationList[i].Offset + InstructionLocationList[i].Size; ++n)
+			{
+				PendingList.push_back({ ++i, advance });
+			}
+		};
+		PushNext(start, 0, 1);
+		while (PendingList.size() > 0)
+		{
+			std::pair<size_t, size_t> state = PendingList.back();
+			PendingList.pop_back();
+			if (std::find(VisitedList.begin(), VisitedList.end(), state) != VisitedList.end())
+			{
+				continue;
+			}
+			if (++step_count > step_limit)
+			{
+				return AccessExtentData { std::string::npos, true };
+			}
+			VisitedList.push_back(state);
+			size_t i = state.first;
+			size_t advance = state.second;
+			const InstructionLocationData &l = InstructionLocationList[i];
+			unsigned short opcode = (ProgramData[l.Offset] << 8) | ProgramData[l.Offset + 1];
+			size_t x = (opcode >> 8) & 0xF;
+			size_t y = (opcode >> 4) & 0xF;
+			size_t access_size = 0;
+			bool next = true;
+			switch (opcode & 0xF000)
+			{
+				case 0x0000:
+				{
+					if (opcode == 0x00EE)
+					{
+						return AccessExtentData { std::string::npos, true };
+					}
+					next = (opcode != 0x00FD);
+					break;
+				}
+				case 0x1000:
+				{
+					size_t target = ((opcode & 0xFFF) >= 0x200) ? FindInstruction((opcode & 0xFFF) - 0x200) : std::string::npos;
+					if (target == std::string::npos)
+					{
+						return AccessExtentData { std::string::npos, true };
+					}
+					PendingList.push_back({ target, advance });
+					next = false;
+					break;
+				}
+				case 0x2000:
+				case 0xB000:
+				{
+					return AccessExtentData { std::string::npos, true };
+				}
+				case 0x5000:
+				{
+					if ((opcode & 0xF) == 0x2 || (opcode & 0xF) == 0x3)
+					{
+						access_size = ((x > y) ? (x - y) : (y - x)) + 1;
+						extent.Written = extent.Written || ((opcode & 0xF) == 0x2);
+					}
+					break;
+				}
+				case 0xA000:
+				{
+					next = false;
+					break;
+				}
+				case 0xD000:
+				{
+					access_size = (((opcode & 0xF) != 0) ? (opcode & 0xF) : 32) * plane_count;
+					break;
+				}
+				case 0xF000:
+				{
+					switch (opcode & 0xFF)
+					{
+						case 0x00:
+						case 0x29:
+						case 0x30:
+						{
+							next = false;
+							break;
+						}
+						case 0x02:
+						{
+							access_size = 16;
+							break;
+						}
+						case 0x1E:
+						case 0x20:
+						case 0x21:
+						case 0xA2:
+						{
+							return AccessExtentData { std::string::npos, true };
+						}
+						case 0x33:
+						{
+							access_size = 3;
+							extent.Written = true;
+							break;
+						}
+						case 0x55:
+						case 0x65:
+						{
+							access_size = x + 1;
+							extent.Written = extent.Written || ((opcode & 0xFF) == 0x55);
+							break;
+						}
+					}
+					break;
+				}
+			}
+			extent.Size = std::max(extent.Size, advance + access_size);
+			if (increment && ((opcode & 0xF0FF) == 0xF055 || (opcode & 0xF0FF) == 0xF065))
+			{
+				advance += x + 1;
+			}
+			if (next)
+			{
+				PushNext(i, advance, IsSkipOpcode(opcode) ? 2 : 1);
+			}
+		}
+		return extent;
+	};
+	for (auto &r : LabelReferenceList)
+	{
+		auto symbol = SymbolIndex.find(r.Name);
+		if (symbol == SymbolIndex.end() || SymbolTable[symbol->second].Location < 0x200)
+		{
+			continue;
+		}
+		size_t offset = SymbolTable[symbol->second].Location - 0x200;
+		AccessExtentData extent = { std::string::npos, true };
+		size_t instruction = r.IsInstruction ? FindInstruction(r.Address) : std::string::npos;
+		if (instruction != std::string::npos)
+		{
+			unsigned short opcode = (ProgramData[r.Address] << 8) | ProgramData[r.Address + 1];
+			if ((opcode & 0xF000) != 0xA000 && opcode != 0xF000)
+			{
+				continue;
+			}
+			extent = GetExtent(instruction);
+		}
+		auto existing = AccessExtentList.emplace(offset, extent);
+		if (!existing.second)
+		{
+			existing.first->second.Size = (extent.Size == std::string::npos || existing.first->second.Size == std::string::npos) ? std::string::npos : std::max(existing.first->second.Size, extent.Size);
+			existing.first->second.Written = existing.first->second.Written || extent.Written;
+		}
+	}
+	return AccessExtentList;
+}
+
+bool BandCHIP_Assembler::Assembler::IsMovable(const std::vector<size_t> &PinnedOffsetList, size_t offset) const
+{
+	size_t segment_end = std::string::npos;
+	for (auto &o : OriginList)
+	{
+		if (o.Offset > offset)
+		{
+			segment_end = o.Offset;
+			break;
+		}
+	}
+	auto pinned = std::lower_bound(PinnedOffsetList.begin(), PinnedOffsetList.end(), offset);
+	return pinned == PinnedOffsetList.end() || *pinned >= segment_end;
+}
+
+std::vector<bool> BandCHIP_Assembler::Assembler::GetJumpTableList() const
+{
+	size_t instruction_count = InstructionLocationList.size();
+	std::vector<bool> JumpTableList(instruction_count, false);
+	for (auto &l : InstructionLocationList)
+	{
+		unsigned short opcode = (ProgramData[l.Offset] << 8) | ProgramData[l.Offset + 1];
+		size_t target = opcode & 0xFFF;
+		if (l.Size != 2 || (opcode & 0xF000) != 0xB000 || target < 0x200)
+		{
+			continue;
+		}
+		auto instruction = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), target - 0x200, [](const InstructionLocationData &data, size_t value) { return data.Offset < value; });
+		if (instruction == InstructionLocationList.end() || instruction->Offset != target - 0x200)
+		{
+			continue;
+		}
+		for (size_t t = instruction - InstructionLocationList.begin(); t < instruction_count; ++t)
+		{
+			const InstructionLocationData &entry = InstructionLocationList[t];
+			JumpTableList[t] = true;
+			if (entry.Size != 2 || (ProgramData[entry.Offset] & 0xF0) != 0x10 || t + 1 >= instruction_count || entry.Offset + entry.Size != InstructionLocationList[t + 1].Offset)
+			{
+				break;
+			}
+		}
+	}
+	return JumpTableList;
+}
+
+void BandCHIP_Assembler::Assembler::PruneUnreachable()
+{
+	size_t instruction_count = InstructionLocationList.size();
+	std::vector<bool> CoveredList(ProgramData.size(), false);
+	for (auto &l : InstructionLocationList)
+	{
+		std::fill(CoveredList.begin() + l.Offset, CoveredList.begin() + l.Offset + l.Size, true);
+	}
+	for (auto &o : OriginList)
+	{
+		std::fill(CoveredList.begin() + o.PadOffset, CoveredList.begin() + o.Offset, true);
+	}
+	std::vector<std::pair<size_t, size_t>> RegionList;
+	std::vector<size_t> RegionIndexList(ProgramData.size(), std::string::npos);
+	for (size_t offset = 0; offset < ProgramData.size(); ++offset)
+	{
+		if (CoveredList[offset])
+		{
+			continue;
+		}
+		if (offset == 0 || CoveredList[offset - 1])
+		{
+			RegionList.push_back({ offset, offset });
+		}
+		RegionList.back().second = offset + 1;
+		RegionIndexList[offset] = RegionList.size() - 1;
+	}
+	auto FindInstruction = [this](size_t offset)
+	{
+		auto instruction = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), offset, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+		return (instruction != InstructionLocationList.end() && instruction->Offset == offset) ? static_cast<size_t>(instruction - InstructionLocationList.begin()) : std::string::npos;
+	};
+	auto GetOpcode = [this](size_t i)
+	{
+		return static_cast<unsigned short>((ProgramData[InstructionLocationList[i].Offset] << 8) | ProgramData[InstructionLocationList[i].Offset + 1]);
+	};
+	std::vector<bool> LiveInstructionList(instruction_count, false);
+	std::vector<bool> LiveRegionList(RegionList.size(), false);
+	std::vector<size_t> InstructionWorkList;
+	std::vector<size_t> RegionWorkList;
+	std::vector<size_t> PinnedOffsetList;
+	auto Mark = [this, &FindInstruction, &RegionIndexList, &LiveInstructionList, &LiveRegionList, &InstructionWorkList, &RegionWorkList](size_t offset, bool code)
+	{
+		if (offset >= ProgramData.size())
+		{
+			return true;
+		}
+		size_t i = FindInstruction(offset);
+		if (i != std::string::npos)
+		{
+			if (!LiveInstructionList[i])
+			{
+				LiveInstructionList[i] = true;
+				InstructionWorkList.push_back(i);
+			}
+			return true;
+		}
+		size_t r = RegionIndexList[offset];
+		if (r != std::string::npos)
+		{
+			if (!LiveRegionList[r])
+			{
+				LiveRegionList[r] = true;
+				RegionWorkList.push_back(r);
+			}
+			return !code;
+		}
+		auto instruction = std::upper_bound(InstructionLocationList.begin(), InstructionLocationList.end(), offset, [](size_t value, const InstructionLocationData &l) { return value < l.Offset; });
+		if (instruction != InstructionLocationList.begin() && offset < (instruction - 1)->Offset + (instruction - 1)->Size)
+		{
+			size_t containing = (instruction - 1) - InstructionLocationList.begin();
+			if (!LiveInstructionList[containing])
+			{
+				LiveInstructionList[containing] = true;
+				InstructionWorkList.push_back(containing);
+			}
+			return !code;
+		}
+		return true;
+	};
+	std::unordered_map<size_t, size_t> ReferenceIndex;
+	for (size_t r = 0; r < LabelReferenceList.size(); ++r)
+	{
+		ReferenceIndex[LabelReferenceList[r].Address] = r;
+	}
+	std::unordered_map<size_t, std::string> LabelIndex;
+	for (auto &s : SymbolTable)
+	{
+		LabelIndex.emplace(s.Location - 0x200, s.Name);
+	}
+	size_t problem_line = 0;
+	if (instruction_count == 0 || !Mark(0, true))
+	{
+		return;
+	}
+	while (problem_line == 0 && (InstructionWorkList.size() > 0 || RegionWorkList.size() > 0))
+	{
+		if (RegionWorkList.size() > 0)
+		{
+			size_t r = RegionWorkList.back();
+			RegionWorkList.pop_back();
+			for (auto &Reference : LabelReferenceList)
+			{
+				auto symbol = SymbolIndex.find(Reference.Name);
+				if (!Reference.IsInstruction && Reference.Address >= RegionList[r].first && Reference.Address < RegionList[r].second && symbol != SymbolIndex.end())
+				{
+					Mark(SymbolTable[symbol->second].Location - 0x200, false);
+				}
+			}
+			continue;
+		}
+		size_t i = InstructionWorkList.back();
+		InstructionWorkList.pop_back();
+		const InstructionLocationData &l = InstructionLocationList[i];
+		unsigned short opcode = GetOpcode(i);
+		size_t target = (l.Size == 4) ? ((ProgramData[l.Offset + 2] << 8) | ProgramData[l.Offset + 3]) : (opcode & 0xFFF);
+		size_t next = l.Offset + l.Size;
+		bool numeric = (ReferenceIndex.find(l.Offset) == ReferenceIndex.end());
+		bool success = true;
+		if (l.Size == 4)
+		{
+			if (opcode == 0xF000 && target >= 0x200)
+			{
+				Mark(target - 0x200, false);
+				if (numeric)
+				{
+					PinnedOffsetList.push_back(target - 0x200);
+				}
+			}
+			success = Mark(next, true);
+		}
+		else if ((opcode & 0xF000) == 0x1000 || (opcode & 0xF000) == 0x2000 || (opcode & 0xF000) == 0xA000 || (opcode & 0xF000) == 0xB000)
+		{
+			if (target >= 0x200)
+			{
+				success = Mark(target - 0x200, (opcode & 0xF000) != 0xA000);
+				if (numeric)
+				{
+					PinnedOffsetList.push_back(target - 0x200);
+				}
+			}
+			if ((opcode & 0xF000) == 0xB000)
+			{
+				for (size_t t = (target >= 0x200) ? FindInstruction(target - 0x200) : std::string::npos; t < instruction_count; ++t)
+				{
+					const InstructionLocationData &entry = InstructionLocationList[t];
+					if (entry.Offset != target - 0x200 && (GetOpcode(t) & 0xF000) != 0x1000 && LabelIndex.find(entry.Offset) != LabelIndex.end())
+					{
+						break;
+					}
+					Mark(entry.Offset, true);
+					if (entry.Size != 2 || (GetOpcode(t) & 0xF000) != 0x1000 || t + 1 >= instruction_count || entry.Offset + entry.Size != InstructionLocationList[t + 1].Offset)
+					{
+						break;
+					}
+				}
+			}
+			if (success && ((opcode & 0xF000) == 0x2000 || (opcode & 0xF000) == 0xA000))
+			{
+				success = Mark(next, true);
+			}
+		}
+		else if (IsSkipOpcode(opcode))
+		{
+			size_t skipped = FindInstruction(next);
+			success = Mark(next, true) && (skipped == std::string::npos || Mark(next + InstructionLocationList[skipped].Size, true));
+		}
+		else if (opcode != 0x00EE && opcode != 0x00FD && (opcode & 0xF0FF) != 0xF020)
+		{
+			success = Mark(next, true);
+		}
+		if (!success)
+		{
+			problem_line = l.LineNumber;
+		}
+	}
+	if (problem_line != 0)
+	{
+		Log << "Skipping dead code removal, since code at line " << problem_line << " runs into data.\n";
+		return;
+	}
+	std::sort(PinnedOffsetList.begin(), PinnedOffsetList.end());
+	auto GetSegmentEnd = [this](size_t offset)
+	{
+		for (auto &o : OriginList)
+		{
+			if (o.Offset > offset)
+			{
+				return o.PadOffset;
+			}
+		}
+		return ProgramData.size();
+	};
+	std::vector<RelayoutData> EditList;
+	size_t removed_instruction_count = 0;
+	size_t removed_region_count = 0;
+	size_t saved_size = 0;
+	for (size_t i = 0; i < instruction_count;)
+	{
+		if (LiveInstructionList[i])
+		{
+			++i;
+			continue;
+		}
+		size_t first = i;
+		size_t end = InstructionLocationList[i].Offset + InstructionLocationList[i].Size;
+		while (++i < instruction_count && !LiveInstructionList[i] && InstructionLocationList[i].Offset == end)
+		{
+			end += InstructionLocationList[i].Size;
+		}
+		size_t offset = InstructionLocationList[first].Offset;
+		if (!IsMovable(PinnedOffsetList, offset))
+		{
+			continue;
+		}
+		auto label = LabelIndex.find(offset);
+		Log << "Removed unreachable code" << ((label != LabelIndex.end()) ? " '" + label->second + "'" : "") << " at line " << InstructionLocationList[first].LineNumber << " (" << (end - offset) << " byte" << ((end - offset != 1) ? "s" : "") << ").\n";
+		EditList.push_back({ offset, end - offset, {} });
+		removed_instruction_count += i - first;
+		saved_size += end - offset;
+	}
+	for (size_t r = 0; r < RegionList.size(); ++r)
+	{
+		size_t offset = RegionList[r].first;
+		size_t size = RegionList[r].second - offset;
+		if (LiveRegionList[r] || !IsMovable(PinnedOffsetList, offset))
+		{
+			continue;
+		}
+		if (size % 2 != 0)
+		{
+			auto instruction = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), RegionList[r].second, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+			if (instruction != InstructionLocationList.end() && instruction->Offset < GetSegmentEnd(offset))
+			{
+				continue;
+			}
+		}
+		auto label = LabelIndex.find(offset);
+		Log << "Removed unreferenced data" << ((label != LabelIndex.end()) ? " '" + label->second + "'" : "") << " (" << size << " byte" << ((size != 1) ? "s" : "") << ").\n";
+		EditList.push_back({ offset, size, {} });
+		++removed_region_count;
+		saved_size += size;
+	}
+	if (EditList.size() == 0)
+	{
+		return;
+	}
+	Relayout(EditList);
+	ResolveReferences();
+	Log << "Removed " << removed_instruction_count << " unreachable instruction" << ((removed_instruction_count != 1) ? "s" : "") << " and " << removed_region_count << " unreferenced data block" << ((removed_region_count != 1) ? "s" : "") << ", saving " << saved_size << " byte" << ((saved_size != 1) ? "s" : "") << ".\n";
+}
+
+void BandCHIP_Assembler::Assembler::PlaceRelocatableData()
+{
+	std::vector<size_t> PinnedOffsetList = GetPinnedOffsetList();
+	std::vector<unsigned char> MovedData;
+	std::vector<std::pair<size_t, size_t>> SymbolMoveList;
+	std::vector<UnresolvedReferenceData> MovedReferenceList;
+	std::vector<UnresolvedReferenceData> MovedUnresolvedList;
+	std::vector<RelayoutData> EditList;
+	size_t moved_count = 0;
+	for (auto &r : RelocatableList)
+	{
+		if (r.Size == 0)
+		{
+			continue;
+		}
+		size_t segment_end = ProgramData.size();
+		for (auto &o : OriginList)
+		{
+			if (o.Offset > r.Offset)
+			{
+				segment_end = o.PadOffset;
+				break;
+			}
+		}
+		auto next = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), r.Offset, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+		if (!IsMovable(PinnedOffsetList, r.Offset))
+		{
+			Log << "Keeping relocatable data at line " << r.LineNumber << " in place, since a numeric address points into or past it.\n";
+			continue;
+		}
+		if ((r.Size & 0x1) != 0 && next != InstructionLocationList.end() && next->Offset < segment_end)
+		{
+			Log << "Keeping relocatable data at line " << r.LineNumber << " in place, since its odd size would move the code after it to an odd address.\n";
+			continue;
+		}
+		size_t base = MovedData.size();
+		MovedData.insert(MovedData.end(), ProgramData.begin() + r.Offset, ProgramData.begin() + r.Offset + r.Size);
+		for (size_t s = 0; s < SymbolTable.size(); ++s)
+		{
+			size_t offset = SymbolTable[s].Location - 0x200;
+			if (SymbolTable[s].Location >= 0x200 && offset >= r.Offset && offset < r.Offset + r.Size)
+			{
+				SymbolMoveList.push_back({ s, base + offset - r.Offset });
+			}
+		}
+		for (auto &Reference : LabelReferenceList)
+		{
+			if (Reference.Address >= r.Offset && Reference.Address < r.Offset + r.Size)
+			{
+				MovedReferenceList.push_back(Reference);
+				MovedReferenceList.back().Address = static_cast<unsigned short>(base + Reference.Address - r.Offset);
+			}
+		}
+		for (auto &u : UnresolvedReferenceList)
+		{
+			if (u.Address >= r.Offset && u.Address < r.Offset + r.Size)
+			{
+				MovedUnresolvedList.push_back(u);
+				MovedUnresolvedList.back().Address = static_cast<unsigned short>(base + u.Address - r.Offset);
+			}
+		}
+		EditList.push_back({ r.Offset, r.Size, {}, {}, {} });
+		++moved_count;
+	}
+	if (EditList.size() == 0 || !Relayout(EditList))
+	{
+		return;
+	}
+	size_t start = std::max<size_t>(ProgramData.size(), 0x1000 - 0x200);
+	if (start > ProgramData.size())
+	{
+		OriginList.push_back({ ProgramData.size(), start });
+		ProgramData.resize(start, 0x00);
+	}
+	ProgramData.insert(ProgramData.end(), MovedData.begin(), MovedData.end());
+	for (auto &m : SymbolMoveList)
+	{
+		SymbolTable[m.first].Location = 0x200 + start + m.second;
+	}
+	for (auto &Reference : MovedReferenceList)
+	{
+		Reference.Address += start;
+		LabelReferenceList.push_back(Reference);
+	}
+	for (auto &u : MovedUnresolvedList)
+	{
+		u.Address += start;
+		UnresolvedReferenceList.push_back(u);
+	}
+	current_address = static_cast<unsigned short>(0x200 + ProgramData.size());
+	Log << "Moved " << moved_count << " relocatable data block" << ((moved_count != 1) ? "s" : "") << " (" << MovedData.size() << " byte" << ((MovedData.size() != 1) ? "s" : "") << ") to 0x" << std::hex << std::uppercase << (0x200 + start) << std::dec << std::nouppercase << ".\n";
+}
+
+void BandCHIP_Assembler::Assembler::ArrangeByProfile()
+{
+	struct ChainData
+	{
+		size_t Offset;
+		size_t Size;
+		bool Code;
+		unsigned long Count;
+	};
+	size_t segment_end = (OriginList.size() > 0) ? OriginList[0].PadOffset : ProgramData.size();
+	std::vector<size_t> PinnedOffsetList = GetPinnedOffsetList();
+	auto pinned = std::lower_bound(PinnedOffsetList.begin(), PinnedOffsetList.end(), segment_end);
+	size_t fixed_end = (pinned != PinnedOffsetList.begin()) ? *(pinned - 1) + 1 : 1;
+	std::vector<size_t> BoundaryList = { 0, segment_end };
+	for (auto &s : SymbolTable)
+	{
+		size_t offset = s.Location - 0x200;
+		bool inside_init = std::any_of(InitList.begin(), InitList.end(), [offset](const RegionData &r) { return offset > r.Offset && offset < r.Offset + r.Size; });
+		if (offset >= fixed_end && offset < segment_end && !inside_init)
+		{
+			BoundaryList.push_back(offset);
+		}
+	}
+	std::sort(BoundaryList.begin(), BoundaryList.end());
+	BoundaryList.erase(std::unique(BoundaryList.begin(), BoundaryList.end()), BoundaryList.end());
+	auto FindInstruction = [this](size_t offset)
+	{
+		return std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), offset, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+	};
+	std::vector<ChainData> ChainList;
+	bool previous_falls = false;
+	bool previous_data = false;
+	for (size_t b = 0; b + 1 < BoundaryList.size(); ++b)
+	{
+		size_t offset = BoundaryList[b];
+		size_t end = BoundaryList[b + 1];
+		auto first = FindInstruction(offset);
+		auto last = FindInstruction(end);
+		bool code = (first != last);
+		bool starts_with_data = (first == InstructionLocationList.end() || first->Offset != offset);
+		bool ends_with_data = !code || (last - 1)->Offset + (last - 1)->Size != end;
+		if (b == 0 || previous_falls || (previous_data && starts_with_data))
+		{
+			if (b == 0)
+			{
+				ChainList.push_back({ offset, 0, true, 0 });
+			}
+			ChainList.back().Size = end - ChainList.back().Offset;
+			ChainList.back().Code = ChainList.back().Code || code;
+		}
+		else
+		{
+			ChainList.push_back({ offset, end - offset, code, 0 });
+		}
+		previous_falls = false;
+		if (!ends_with_data)
+		{
+			unsigned short opcode = (ProgramData[(last - 1)->Offset] << 8) | ProgramData[(last - 1)->Offset + 1];
+			bool conditional = (last - 1 != first && (last - 2)->Offset + (last - 2)->Size == (last - 1)->Offset && IsSkipOpcode((ProgramData[(last - 2)->Offset] << 8) | ProgramData[(last - 2)->Offset + 1]));
+			bool ends = ((last - 1)->Size == 2 && ((opcode & 0xF000) == 0x1000 || (opcode & 0xF000) == 0xB000 || opcode == 0x00EE || opcode == 0x00FD || (CurrentExtension == ExtensionType::HyperCHIP64 && (opcode & 0xF0FF) == 0xF020)));
+			previous_falls = conditional || !ends;
+		}
+		previous_data = ends_with_data;
+	}
+	for (auto &s : SymbolTable)
+	{
+		auto profile = ProfileIndex.find(s.Name);
+		if (profile == ProfileIndex.end() || s.Location - 0x200 >= segment_end)
+		{
+			continue;
+		}
+		auto chain = std::upper_bound(ChainList.begin(), ChainList.end(), s.Location - 0x200, [](size_t value, const ChainData &c) { return value < c.Offset; }) - 1;
+		chain->Count += profile->second;
+	}
+	std::vector<size_t> OrderList;
+	for (size_t c = 1; c < ChainList.size(); ++c)
+	{
+		OrderList.push_back(c);
+	}
+	std::stable_sort(OrderList.begin(), OrderList.end(), [&ChainList](size_t a, size_t b)
+	{
+		int a_rank = ChainList[a].Code ? ((ChainList[a].Count > 0) ? 0 : 1) : 2;
+		int b_rank = ChainList[b].Code ? ((ChainList[b].Count > 0) ? 0 : 1) : 2;
+		if (a_rank != b_rank)
+		{
+			return a_rank < b_rank;
+		}
+		return a_rank == 0 && ChainList[a].Count > ChainList[b].Count;
+	});
+	OrderList.insert(OrderList.begin(), 0);
+	size_t position = 0;
+	size_t hot_count = 0;
+	size_t hot_size = 0;
+	std::vector<std::pair<size_t, size_t>> MoveList;
+	for (auto c : OrderList)
+	{
+		if (ChainList[c].Code && (position & 0x1) != 0)
+		{
+			Log << "Skipping profile-guided layout, since code would end up at an odd address.\n";
+			return;
+		}
+		if (c != 0 && ChainList[c].Code && ChainList[c].Count > 0)
+		{
+			++hot_count;
+			hot_size += ChainList[c].Size;
+		}
+		MoveList.push_back({ ChainList[c].Offset, position });
+		position += ChainList[c].Size;
+	}
+	std::sort(MoveList.begin(), MoveList.end());
+	auto MapOffset = [&MoveList, segment_end](size_t offset)
+	{
+		if (offset >= segment_end)
+		{
+			return offset;
+		}
+		auto move = std::upper_bound(MoveList.begin(), MoveList.end(), std::make_pair(offset, std::string::npos)) - 1;
+		return move->second + (offset - move->first);
+	};
+	std::vector<unsigned char> NewProgramData(ProgramData);
+	for (auto c : OrderList)
+	{
+		std::copy(ProgramData.begin() + ChainList[c].Offset, ProgramData.begin() + ChainList[c].Offset + ChainList[c].Size, NewProgramData.begin() + MapOffset(ChainList[c].Offset));
+	}
+	ProgramData = std::move(NewProgramData);
+	for (auto &s : SymbolTable)
+	{
+		s.Location = MapOffset(s.Location - 0x200) + 0x200;
+	}
+	for (auto &r : LabelReferenceList)
+	{
+		r.Address = static_cast<unsigned short>(MapOffset(r.Address));
+	}
+	for (auto &u : UnresolvedReferenceList)
+	{
+		u.Address = static_cast<unsigned short>(MapOffset(u.Address));
+	}
+	for (auto &l : InstructionLocationList)
+	{
+		l.Offset = MapOffset(l.Offset);
+	}
+	std::sort(InstructionLocationList.begin(), InstructionLocationList.end(), [](const InstructionLocationData &a, const InstructionLocationData &b) { return a.Offset < b.Offset; });
+	for (auto &r : InitList)
+	{
+		r.Offset = MapOffset(r.Offset);
+	}
+	Log << "Arranged " << (ChainList.size() - 1) << " block" << ((ChainList.size() != 2) ? "s" : "") << " by profile, placing " << hot_count << " hot block" << ((hot_count != 1) ? "s" : "") << " (" << hot_size << " byte" << ((hot_size != 1) ? "s" : "") << ") first.\n";
+}
+
+void BandCHIP_Assembler::Assembler::DeduplicateData()
+{
+	std::vector<bool> FixedList(ProgramData.size(), false);
+	std::vector<size_t> BoundaryList = { ProgramData.size() };
+	for (auto &l : InstructionLocationList)
+	{
+		std::fill(FixedList.begin() + l.Offset, FixedList.begin() + l.Offset + l.Size, true);
+		BoundaryList.push_back(l.Offset);
+	}
+	for (auto &r : LabelReferenceList)
+	{
+		size_t reference_end = std::min(ProgramData.size(), r.Address + static_cast<size_t>(r.LongAddress ? 4 : 2));
+		if (r.Address < reference_end)
+		{
+			std::fill(FixedList.begin() + r.Address, FixedList.begin() + reference_end, true);
+		}
+	}
+	for (auto &o : OriginList)
+	{
+		BoundaryList.push_back(o.PadOffset);
+		BoundaryList.push_back(o.Offset);
+	}
+	std::vector<size_t> SymbolOrderList(SymbolTable.size());
+	for (size_t s = 0; s < SymbolTable.size(); ++s)
+	{
+		SymbolOrderList[s] = s;
+		BoundaryList.push_back(SymbolTable[s].Location - 0x200);
+	}
+	std::sort(BoundaryList.begin(), BoundaryList.end());
+	std::stable_sort(SymbolOrderList.begin(), SymbolOrderList.end(), [this](size_t a, size_t b) { return SymbolTable[a].Location < SymbolTable[b].Location; });
+	std::map<size_t, AccessExtentData> AccessExtentList = GetAccessExtentList();
+	auto IsFoldable = [this, &AccessExtentList](size_t offset, size_t end)
+	{
+		size_t segment_start = 0;
+		for (auto &o : OriginList)
+		{
+			if (o.Offset <= offset)
+			{
+				segment_start = o.Offset;
+			}
+		}
+		for (auto extent = AccessExtentList.lower_bound(segment_start); extent != AccessExtentList.end() && extent->first <= offset; ++extent)
+		{
+			size_t limit = (extent->first == offset) ? end : offset;
+			if (extent->second.Size == std::string::npos || extent->first + extent->second.Size > limit)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+	std::vector<size_t> PinnedOffsetList = GetPinnedOffsetList();
+	std::unordered_map<std::string, size_t> BlockIndex;
+	std::vector<RelayoutData> EditList;
+	std::vector<std::pair<size_t, size_t>> AliasList;
+	size_t saved_size = 0;
+	for (size_t s = 0; s < SymbolOrderList.size();)
+	{
+		size_t group_end = s + 1;
+		while (group_end < SymbolOrderList.size() && SymbolTable[SymbolOrderList[group_end]].Location == SymbolTable[SymbolOrderList[s]].Location)
+		{
+			++group_end;
+		}
+		size_t group_start = s;
+		s = group_end;
+		size_t offset = SymbolTable[SymbolOrderList[group_start]].Location - 0x200;
+		if (offset >= ProgramData.size())
+		{
+			continue;
+		}
+		size_t end = *std::upper_bound(BoundaryList.begin(), BoundaryList.end(), offset);
+		auto extent = AccessExtentList.find(offset);
+		if (std::find(FixedList.begin() + offset, FixedList.begin() + end, true) != FixedList.begin() + end || (extent != AccessExtentList.end() && extent->second.Written))
+		{
+			continue;
+		}
+		auto block = BlockIndex.emplace(std::string(ProgramData.begin() + offset, ProgramData.begin() + end), SymbolOrderList[group_start]);
+		if (block.second || !IsMovable(PinnedOffsetList, offset) || !IsFoldable(offset, end))
+		{
+			continue;
+		}
+		if ((end - offset) % 2 != 0)
+		{
+			size_t segment_end = ProgramData.size();
+			for (auto &o : OriginList)
+			{
+				if (o.Offset > offset)
+				{
+					segment_end = o.PadOffset;
+					break;
+				}
+			}
+			auto instruction = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), end, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+			if (instruction != InstructionLocationList.end() && instruction->Offset < segment_end)
+			{
+				continue;
+			}
+		}
+		EditList.push_back({ offset, end - offset, {} });
+		for (size_t a = group_start; a < group_end; ++a)
+		{
+			AliasList.push_back({ SymbolOrderList[a], block.first->second });
+		}
+		saved_size += end - offset;
+	}
+	if (EditList.size() == 0)
+	{
+		return;
+	}
+	Relayout(EditList);
+	for (auto &a : AliasList)
+	{
+		SymbolTable[a.first].Location = SymbolTable[a.second].Location;
+	}
+	ResolveReferences();
+	Log << "Folded " << EditList.size() << " duplicate data block" << ((EditList.size() != 1) ? "s" : "") << ", saving " << saved_size << " byte" << ((saved_size != 1) ? "s" : "") << ".\n";
+}
+
+void BandCHIP_Assembler::Assembler::OutlineSequences()
+{
+	size_t outline_count = 0;
+	size_t saved_size = 0;
+	while (true)
+	{
+		size_t instruction_count = InstructionLocationList.size();
+		std::vector<size_t> LabelOffsetList;
+		for (auto &s : SymbolTable)
+		{
+			LabelOffsetList.push_back(s.Location - 0x200);
+		}
+		std::sort(LabelOffsetList.begin(), LabelOffsetList.end());
+		std::unordered_map<size_t, size_t> ReferenceIndex;
+		for (size_t r = 0; r < LabelReferenceList.size(); ++r)
+		{
+			if (LabelReferenceList[r].IsInstruction)
+			{
+				ReferenceIndex[LabelReferenceList[r].Address] = r;
+			}
+		}
+		std::vector<bool> JumpTableList = GetJumpTableList();
+		std::vector<size_t> PinnedOffsetList = GetPinnedOffsetList();
+		std::unordered_map<std::string, size_t> TokenIndex;
+		std::vector<size_t> TokenList;
+		std::vector<size_t> TokenInstructionList;
+		size_t token_count = 0;
+		auto AddToken = [&TokenList, &TokenInstructionList](size_t token, size_t instruction)
+		{
+			TokenList.push_back(token);
+			TokenInstructionList.push_back(instruction);
+		};
+		for (size_t i = 0; i < instruction_count; ++i)
+		{
+			const InstructionLocationData &l = InstructionLocationList[i];
+			unsigned short opcode = (ProgramData[l.Offset] << 8) | ProgramData[l.Offset + 1];
+			if (i == 0 || InstructionLocationList[i - 1].Offset + InstructionLocationList[i - 1].Size != l.Offset || std::binary_search(LabelOffsetList.begin(), LabelOffsetList.end(), l.Offset))
+			{
+				AddToken(token_count++, std::string::npos);
+			}
+			auto reference = ReferenceIndex.find(l.Offset);
+			bool outlinable = !JumpTableList[i] && (l.Size == 4 || ((opcode & 0xF000) != 0x2000 && (IsSkipOpcode(opcode) || !EndsBasicBlock(opcode))));
+			if (reference != ReferenceIndex.end() && SymbolIndex.find(LabelReferenceList[reference->second].Name) == SymbolIndex.end())
+			{
+				outlinable = false;
+			}
+			if (!outlinable)
+			{
+				AddToken(token_count++, i);
+				continue;
+			}
+			std::string key = (reference != ReferenceIndex.end()) ? std::string(1, static_cast<char>(ProgramData[l.Offset] & 0xF0)) + static_cast<char>(l.Size) + LabelReferenceList[reference->second].Name : std::string(ProgramData.begin() + l.Offset, ProgramData.begin() + l.Offset + l.Size);
+			auto token = TokenIndex.emplace(key, token_count);
+			if (token.second)
+			{
+				++token_count;
+			}
+			AddToken(token.first->second, i);
+		}
+		size_t n = TokenList.size();
+		if (n < 2)
+		{
+			break;
+		}
+		std::vector<size_t> SuffixArray(n);
+		std::vector<size_t> RankList(TokenList);
+		std::vector<size_t> NextRankList(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			SuffixArray[i] = i;
+		}
+		for (size_t k = 1;; k <<= 1)
+		{
+			auto CompareSuffix = [&RankList, k, n](size_t a, size_t b)
+			{
+				if (RankList[a] != RankList[b])
+				{
+					return RankList[a] < RankList[b];
+				}
+				return ((a + k < n) ? static_cast<long>(RankList[a + k]) : -1L) < ((b + k < n) ? static_cast<long>(RankList[b + k]) : -1L);
+			};
+			std::sort(SuffixArray.begin(), SuffixArray.end(), CompareSuffix);
+			NextRankList[SuffixArray[0]] = 0;
+			for (size_t i = 1; i < n; ++i)
+			{
+				NextRankList[SuffixArray[i]] = NextRankList[SuffixArray[i - 1]] + (CompareSuffix(SuffixArray[i - 1], SuffixArray[i]) ? 1 : 0);
+			}
+			RankList.swap(NextRankList);
+			if (RankList[SuffixArray[n - 1]] == n - 1)
+			{
+				break;
+			}
+		}
+		std::vector<size_t> LCPList(n + 1, 0);
+		for (size_t i = 0, h = 0; i < n; ++i)
+		{
+			if (RankList[i] == 0)
+			{
+				h = 0;
+				continue;
+			}
+			size_t j = SuffixArray[RankList[i] - 1];
+			while (i + h < n && j + h < n && TokenList[i + h] == TokenList[j + h])
+			{
+				++h;
+			}
+			LCPList[RankList[i]] = h;
+			if (h > 0)
+			{
+				--h;
+			}
+		}
+		auto GetOpcode = [this, &TokenInstructionList](size_t token)
+		{
+			const InstructionLocationData &l = InstructionLocationList[TokenInstructionList[token]];
+			return static_cast<unsigned short>((ProgramData[l.Offset] << 8) | ProgramData[l.Offset + 1]);
+		};
+		size_t final_segment = OriginList.size() ? OriginList.back().Offset : 0;
+		long best_gain = 0;
+		size_t best_length = 0;
+		size_t best_size = 0;
+		std::vector<size_t> BestOccurrenceList;
+		auto EvaluateCandidate = [this, &SuffixArray, &TokenInstructionList, &PinnedOffsetList, &GetOpcode, final_segment, &best_gain, &best_length, &best_size, &BestOccurrenceList](size_t length, size_t first, size_t last)
+		{
+			std::vector<size_t> PositionList(SuffixArray.begin() + first, SuffixArray.begin() + last + 1);
+			std::sort(PositionList.begin(), PositionList.end());
+			const InstructionLocationData &tail = InstructionLocationList[TokenInstructionList[PositionList[0] + length - 1]];
+			if (tail.Size == 2 && IsSkipOpcode(GetOpcode(PositionList[0] + length - 1)))
+			{
+				--length;
+			}
+			if (length == 0)
+			{
+				return;
+			}
+			size_t size = 0;
+			for (size_t t = 0; t < length; ++t)
+			{
+				size += InstructionLocationList[TokenInstructionList[PositionList[0] + t]].Size;
+			}
+			std::vector<size_t> OccurrenceList;
+			size_t occurrence_end = 0;
+			long gain = -static_cast<long>(size + 2 + (ProgramData.size() % 2));
+			for (auto p : PositionList)
+			{
+				size_t i = TokenInstructionList[p];
+				const InstructionLocationData &l = InstructionLocationList[i];
+				bool after_skip = i > 0 && InstructionLocationList[i - 1].Offset + InstructionLocationList[i - 1].Size == l.Offset && InstructionLocationList[i - 1].Size == 2 && IsSkipOpcode((ProgramData[l.Offset - 2] << 8) | ProgramData[l.Offset - 1]);
+				if (p < occurrence_end || after_skip || !IsMovable(PinnedOffsetList, l.Offset))
+				{
+					continue;
+				}
+				OccurrenceList.push_back(p);
+				occurrence_end = p + length;
+				if (l.Offset >= final_segment)
+				{
+					gain += static_cast<long>(size) - 2;
+				}
+			}
+			if (OccurrenceList.size() < 2 || gain <= best_gain)
+			{
+				return;
+			}
+			best_gain = gain;
+			best_length = length;
+			best_size = size;
+			BestOccurrenceList = std::move(OccurrenceList);
+		};
+		std::vector<std::pair<size_t, size_t>> IntervalStack;
+		for (size_t i = 1; i <= n; ++i)
+		{
+			size_t left = i - 1;
+			while (IntervalStack.size() > 0 && IntervalStack.back().first > LCPList[i])
+			{
+				left = IntervalStack.back().second;
+				EvaluateCandidate(IntervalStack.back().first, left, i - 1);
+				IntervalStack.pop_back();
+			}
+			if (LCPList[i] > 0 && (IntervalStack.size() == 0 || IntervalStack.back().first < LCPList[i]))
+			{
+				IntervalStack.push_back({ LCPList[i], left });
+			}
+		}
+		size_t body_offset = ProgramData.size() + (ProgramData.size() % 2);
+		for (auto p : BestOccurrenceList)
+		{
+			if (InstructionLocationList[TokenInstructionList[p]].Offset >= final_segment)
+			{
+				body_offset -= best_size - 2;
+			}
+		}
+		if (BestOccurrenceList.size() == 0 || 0x200 + body_offset > 0xFFF)
+		{
+			break;
+		}
+		std::string name = "@outline" + std::to_string(outline_count);
+		while (SymbolIndex.find(name) != SymbolIndex.end())
+		{
+			name += '_';
+		}
+		size_t first = TokenInstructionList[BestOccurrenceList[0]];
+		size_t body_start = InstructionLocationList[first].Offset;
+		std::vector<unsigned char> BodyData(ProgramData.begin() + body_start, ProgramData.begin() + body_start + best_size);
+		BodyData.push_back(0x00);
+		BodyData.push_back(0xEE);
+		std::vector<UnresolvedReferenceData> BodyReferenceList;
+		std::vector<InstructionLocationData> BodyInstructionList;
+		for (size_t t = 0; t < best_length; ++t)
+		{
+			const InstructionLocationData &l = InstructionLocationList[first + t];
+			auto reference = ReferenceIndex.find(l.Offset);
+			if (reference != ReferenceIndex.end())
+			{
+				BodyReferenceList.push_back(LabelReferenceList[reference->second]);
+				BodyReferenceList.back().Address = static_cast<unsigned short>(body_offset + l.Offset - body_start);
+			}
+			BodyInstructionList.push_back({ body_offset + l.Offset - body_start, l.Size, l.LineNumber });
+		}
+		BodyInstructionList.push_back({ body_offset + best_size, 2, InstructionLocationList[first + best_length - 1].LineNumber });
+		std::vector<RelayoutData> EditList;
+		for (auto p : BestOccurrenceList)
+		{
+			const InstructionLocationData &l = InstructionLocationList[TokenInstructionList[p]];
+			EditList.push_back({ l.Offset, best_size, { 0x20, 0x00 }, { { name, l.LineNumber, 0, true, false } } });
+		}
+		if (!Relayout(EditList))
+		{
+			break;
+		}
+		ProgramData.resize(body_offset, 0x00);
+		ProgramData.insert(ProgramData.end(), BodyData.begin(), BodyData.end());
+		current_address = static_cast<unsigned short>(0x200 + ProgramData.size());
+		LabelReferenceList.insert(LabelReferenceList.end(), BodyReferenceList.begin(), BodyReferenceList.end());
+		InstructionLocationList.insert(InstructionLocationList.end(), BodyInstructionList.begin(), BodyInstructionList.end());
+		SymbolIndex[name] = SymbolTable.size();
+		SymbolTable.push_back({ name, SymbolType::Label, 0x200 + body_offset });
+		++outline_count;
+		saved_size += best_gain;
+	}
+	if (outline_count > 0)
+	{
+		Log << "Outlined " << outline_count << " repeated sequence" << ((outline_count != 1) ? "s" : "") << " into subroutines, saving " << saved_size << " byte" << ((saved_size != 1) ? "s" : "") << ".\n";
+	}
+}
+
+void BandCHIP_Assembler::Assembler::InlineSubroutines()
+{
+	const size_t maximum_body_size = 8;
+	size_t instruction_count = InstructionLocationList.size();
+	size_t memory_end = (CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64) ? 0x10000 : 0x1000;
+	std::vector<bool> JumpTableList = GetJumpTableList();
+	std::vector<size_t> PinnedOffsetList = GetPinnedOffsetList();
+	std::unordered_map<size_t, size_t> ReferenceIndex;
+	std::vector<size_t> TargetOffsetList;
+	for (size_t r = 0; r < LabelReferenceList.size(); ++r)
+	{
+		const UnresolvedReferenceData &Reference = LabelReferenceList[r];
+		auto symbol = SymbolIndex.find(Reference.Name);
+		if (!Reference.IsInstruction)
+		{
+			continue;
+		}
+		ReferenceIndex[Reference.Address] = r;
+		if (!Reference.LongAddress && symbol != SymbolIndex.end())
+		{
+			TargetOffsetList.push_back(SymbolTable[symbol->second].Location - 0x200);
+		}
+	}
+	std::sort(TargetOffsetList.begin(), TargetOffsetList.end());
+	TargetOffsetList.erase(std::unique(TargetOffsetList.begin(), TargetOffsetList.end()), TargetOffsetList.end());
+	auto GetOpcode = [this](size_t i)
+	{
+		return static_cast<unsigned short>((ProgramData[InstructionLocationList[i].Offset] << 8) | ProgramData[InstructionLocationList[i].Offset + 1]);
+	};
+	auto IsContiguous = [this](size_t i)
+	{
+		return i > 0 && InstructionLocationList[i - 1].Offset + InstructionLocationList[i - 1].Size == InstructionLocationList[i].Offset;
+	};
+	auto GetSegment = [this](size_t offset)
+	{
+		size_t segment = 0;
+		while (segment < OriginList.size() && OriginList[segment].Offset <= offset)
+		{
+			++segment;
+		}
+		return segment;
+	};
+	std::unordered_map<std::string, std::pair<size_t, size_t>> BodyIndex;
+	auto GetBody = [this, instruction_count, maximum_body_size, &JumpTableList, &ReferenceIndex, &GetOpcode, &IsContiguous, &BodyIndex](const std::string &name)
+	{
+		auto body = BodyIndex.find(name);
+		if (body != BodyIndex.end())
+		{
+			return body->second;
+		}
+		std::pair<size_t, size_t> Body = { std::string::npos, 0 };
+		size_t offset = SymbolTable[SymbolIndex.find(name)->second].Location - 0x200;
+		auto instruction = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), offset, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+		size_t body_size = 0;
+		for (size_t i = instruction - InstructionLocationList.begin(); i < instruction_count && InstructionLocationList[i].Offset == offset + body_size; ++i)
+		{
+			const InstructionLocationData &l = InstructionLocationList[i];
+			unsigned short opcode = GetOpcode(i);
+			if (l.Size == 2 && opcode == 0x00EE)
+			{
+				if (!JumpTableList[i] && (body_size == 0 || !IsContiguous(i) || InstructionLocationList[i - 1].Size != 2 || !IsSkipOpcode(GetOpcode(i - 1))))
+				{
+					Body = { static_cast<size_t>(instruction - InstructionLocationList.begin()), i - (instruction - InstructionLocationList.begin()) };
+				}
+				break;
+			}
+			auto reference = ReferenceIndex.find(l.Offset);
+			if (JumpTableList[i] || (l.Size == 2 && EndsBasicBlock(opcode) && !IsSkipOpcode(opcode)) || (reference != ReferenceIndex.end() && SymbolIndex.find(LabelReferenceList[reference->second].Name) == SymbolIndex.end()))
+			{
+				break;
+			}
+			body_size += l.Size;
+			if (body_size > maximum_body_size)
+			{
+				break;
+			}
+		}
+		BodyIndex[name] = Body;
+		return Body;
+	};
+	std::vector<long> SegmentGrowthList(OriginList.size() + 1, 0);
+	std::vector<std::pair<size_t, long>> GrowthList;
+	auto Fits = [this, memory_end, &TargetOffsetList, &SegmentGrowthList, &GrowthList, &GetSegment](size_t offset, long delta)
+	{
+		size_t segment = GetSegment(offset);
+		long segment_growth = SegmentGrowthList[segment] + delta;
+		if (segment < OriginList.size() ? (segment_growth > static_cast<long>(OriginList[segment].Offset - OriginList[segment].PadOffset)) : (0x200 + static_cast<long>(ProgramData.size()) + segment_growth > static_cast<long>(memory_end)))
+		{
+			return false;
+		}
+		size_t segment_end = (segment < OriginList.size()) ? OriginList[segment].Offset : std::string::npos;
+		for (auto t = std::upper_bound(TargetOffsetList.begin(), TargetOffsetList.end(), offset); t != TargetOffsetList.end() && *t < segment_end; ++t)
+		{
+			long growth = delta;
+			for (auto &g : GrowthList)
+			{
+				if (g.first < *t && GetSegment(g.first) == segment)
+				{
+					growth += g.second;
+				}
+			}
+			if (0x200 + static_cast<long>(*t) + growth > 0xFFF)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+	std::vector<RelayoutData> EditList;
+	for (size_t i = 0; i < instruction_count; ++i)
+	{
+		const InstructionLocationData &l = InstructionLocationList[i];
+		auto reference = ReferenceIndex.find(l.Offset);
+		if (l.Size != 2 || (GetOpcode(i) & 0xF000) != 0x2000 || JumpTableList[i] || reference == ReferenceIndex.end() || SymbolIndex.find(LabelReferenceList[reference->second].Name) == SymbolIndex.end())
+		{
+			continue;
+		}
+		std::pair<size_t, size_t> Body = GetBody(LabelReferenceList[reference->second].Name);
+		if (Body.first == std::string::npos)
+		{
+			continue;
+		}
+		size_t body_start = InstructionLocationList[Body.first].Offset;
+		size_t body_size = (Body.second > 0) ? InstructionLocationList[Body.first + Body.second - 1].Offset + InstructionLocationList[Body.first + Body.second - 1].Size - body_start : 0;
+		bool after_skip = IsContiguous(i) && InstructionLocationList[i - 1].Size == 2 && IsSkipOpcode(GetOpcode(i - 1));
+		long delta = static_cast<long>(body_size) - 2;
+		if ((after_skip && body_size != 2) || (delta != 0 && !IsMovable(PinnedOffsetList, l.Offset)) || !Fits(l.Offset, delta))
+		{
+			continue;
+		}
+		RelayoutData Edit = { l.Offset, 2, std::vector<unsigned char>(ProgramData.begin() + body_start, ProgramData.begin() + body_start + body_size), {}, {} };
+		for (size_t b = Body.first; b < Body.first + Body.second; ++b)
+		{
+			const InstructionLocationData &BodyInstruction = InstructionLocationList[b];
+			auto body_reference = ReferenceIndex.find(BodyInstruction.Offset);
+			if (body_reference != ReferenceIndex.end())
+			{
+				Edit.NewReferenceList.push_back(LabelReferenceList[body_reference->second]);
+				Edit.NewReferenceList.back().LineNumber = l.LineNumber;
+				Edit.NewReferenceList.back().Address = static_cast<unsigned short>(BodyInstruction.Offset - body_start);
+			}
+			Edit.NewInstructionList.push_back({ BodyInstruction.Offset - body_start, BodyInstruction.Size, l.LineNumber });
+		}
+		SegmentGrowthList[GetSegment(l.Offset)] += delta;
+		GrowthList.push_back({ l.Offset, delta });
+		EditList.push_back(std::move(Edit));
+	}
+	if (EditList.size() == 0)
+	{
+		return;
+	}
+	Relayout(EditList);
+	Log << "Inlined " << EditList.size() << " subroutine call" << ((EditList.size() != 1) ? "s" : "") << ".\n";
+}
+
+void BandCHIP_Assembler::Assembler::Optimize()
+{
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		std::vector<size_t> LabelOffsetList;
+		for (auto &s : SymbolTable)
+		{
+			LabelOffsetList.push_back(s.Location - 0x200);
+		}
+		std::sort(LabelOffsetList.begin(), LabelOffsetList.end());
+		std::unordered_map<size_t, size_t> ReferenceIndex;
+		for (size_t r = 0; r < LabelReferenceList.size(); ++r)
+		{
+			if (LabelReferenceList[r].IsInstruction)
+			{
+				ReferenceIndex[LabelReferenceList[r].Address] = r;
+			}
+		}
+		auto IsLabelled = [&LabelOffsetList](size_t offset)
+		{
+			return std::binary_search(LabelOffsetList.begin(), LabelOffsetList.end(), offset);
+		};
+		auto GetOpcode = [this](const InstructionLocationData &l)
+		{
+			return static_cast<unsigned short>((ProgramData[l.Offset] << 8) | ProgramData[l.Offset + 1]);
+		};
+		auto FindInstruction = [this](size_t offset)
+		{
+			auto instruction = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), offset, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+			return (instruction != InstructionLocationList.end() && instruction->Offset == offset) ? static_cast<size_t>(instruction - InstructionLocationList.begin()) : std::string::npos;
+		};
+		auto IsExternal = [this, &ReferenceIndex](size_t offset)
+		{
+			auto reference = ReferenceIndex.find(offset);
+			return reference != ReferenceIndex.end() && SymbolIndex.find(LabelReferenceList[reference->second].Name) == SymbolIndex.end();
+		};
+		auto IsContiguous = [this](size_t i)
+		{
+			return i > 0 && InstructionLocationList[i - 1].Offset + InstructionLocationList[i - 1].Size == InstructionLocationList[i].Offset;
+		};
+		size_t instruction_count = InstructionLocationList.size();
+		std::vector<bool> ProtectedList = GetJumpTableList();
+		std::vector<size_t> PinnedOffsetList = GetPinnedOffsetList();
+		std::vector<RelayoutData> EditList;
+		bool address_known = false;
+		std::string address_value = "";
+		bool merge_supported = (CurrentExtension == ExtensionType::CHIP8 || CurrentExtension == ExtensionType::SuperCHIP10 || CurrentExtension == ExtensionType::SuperCHIP11);
+		std::array<int, 16> RegisterValueList;
+		RegisterValueList.fill(-1);
+		for (size_t i = 0; i < instruction_count; ++i)
+		{
+			const InstructionLocationData &l = InstructionLocationList[i];
+			unsigned short opcode = GetOpcode(l);
+			bool after_skip = IsContiguous(i) && InstructionLocationList[i - 1].Size == 2 && IsSkipOpcode(GetOpcode(InstructionLocationList[i - 1]));
+			bool removable = !after_skip && !ProtectedList[i] && IsMovable(PinnedOffsetList, l.Offset);
+			if (!IsContiguous(i) || IsLabelled(l.Offset) || std::binary_search(PinnedOffsetList.begin(), PinnedOffsetList.end(), l.Offset))
+			{
+				address_known = false;
+				RegisterValueList.fill(-1);
+			}
+			if (l.Size == 2 && (opcode & 0xF000) == 0x1000 && !IsExternal(l.Offset))
+			{
+				size_t target = opcode & 0xFFF;
+				size_t final_target = target;
+				size_t source = std::string::npos;
+				for (size_t hop = 0; hop < instruction_count && final_target >= 0x200; ++hop)
+				{
+					size_t j = FindInstruction(final_target - 0x200);
+					if (j == std::string::npos || j == i || InstructionLocationList[j].Size != 2)
+					{
+						break;
+					}
+					unsigned short target_opcode = GetOpcode(InstructionLocationList[j]);
+					if ((target_opcode & 0xF000) != 0x1000 || IsExternal(InstructionLocationList[j].Offset) || (target_opcode & 0xFFF) == final_target)
+					{
+						break;
+					}
+					final_target = target_opcode & 0xFFF;
+					source = j;
+				}
+				auto reference = ReferenceIndex.find(l.Offset);
+				auto source_reference = (source != std::string::npos) ? ReferenceIndex.find(InstructionLocationList[source].Offset) : ReferenceIndex.end();
+				if (final_target != target && (source_reference != ReferenceIndex.end() || reference == ReferenceIndex.end()))
+				{
+					ProgramData[l.Offset] = 0x10 | ((final_target & 0xF00) >> 8);
+					ProgramData[l.Offset + 1] = final_target & 0xFF;
+					if (source_reference != ReferenceIndex.end())
+					{
+						if (reference != ReferenceIndex.end())
+						{
+							LabelReferenceList[reference->second].Name = LabelReferenceList[source_reference->second].Name;
+						}
+						else
+						{
+							LabelReferenceList.push_back({ LabelReferenceList[source_reference->second].Name, l.LineNumber, static_cast<unsigned short>(l.Offset), true, false });
+						}
+					}
+					target = final_target;
+					changed = true;
+				}
+				if (target == 0x200 + l.Offset + l.Size && removable)
+				{
+					EditList.push_back({ l.Offset, l.Size, {} });
+					changed = true;
+				}
+				address_known = false;
+				RegisterValueList.fill(-1);
+				continue;
+			}
+			if (l.Size == 2 && (opcode & 0xF000) == 0x2000 && i + 1 < instruction_count && IsContiguous(i + 1) && InstructionLocationList[i + 1].Size == 2 && GetOpcode(InstructionLocationList[i + 1]) == 0x00EE)
+			{
+				ProgramData[l.Offset] = 0x10 | (ProgramData[l.Offset] & 0x0F);
+				if (!after_skip && !ProtectedList[i + 1] && !IsLabelled(InstructionLocationList[i + 1].Offset) && IsMovable(PinnedOffsetList, InstructionLocationList[i + 1].Offset))
+				{
+					EditList.push_back({ InstructionLocationList[i + 1].Offset, 2, {} });
+					++i;
+				}
+				address_known = false;
+				RegisterValueList.fill(-1);
+				changed = true;
+				continue;
+			}
+			if ((l.Size == 2 && (opcode & 0xF000) == 0xA000) || (l.Size == 4 && opcode == 0xF000))
+			{
+				auto reference = ReferenceIndex.find(l.Offset);
+				std::string value = IsExternal(l.Offset) ? ':' + LabelReferenceList[reference->second].Name : std::to_string((l.Size == 4) ? ((ProgramData[l.Offset + 2] << 8) | ProgramData[l.Offset + 3]) : (opcode & 0xFFF));
+				if (address_known && value == address_value && removable)
+				{
+					EditList.push_back({ l.Offset, l.Size, {} });
+					changed = true;
+					continue;
+				}
+				address_known = !after_skip;
+				address_value = value;
+				continue;
+			}
+			if (l.Size == 2 && (opcode & 0xF000) == 0xD000 && (opcode & 0xF) != 0 && merge_supported && !after_skip && address_known && address_value[0] != ':')
+			{
+				size_t x = (opcode >> 8) & 0xF;
+				size_t y = (opcode >> 4) & 0xF;
+				size_t height = opcode & 0xF;
+				size_t sprite_address = std::stoul(address_value);
+				size_t current_address_value = sprite_address;
+				size_t row_offset = 0;
+				size_t merge = std::string::npos;
+				for (size_t j = i + 1; j < instruction_count && x != y && x != 0xF && y != 0xF && RegisterValueList[y] >= 0; ++j)
+				{
+					const InstructionLocationData &next = InstructionLocationList[j];
+					if (!IsContiguous(j) || IsLabelled(next.Offset) || ProtectedList[j] || !IsMovable(PinnedOffsetList, next.Offset))
+					{
+						break;
+					}
+					unsigned short next_opcode = GetOpcode(next);
+					if (next.Size == 2 && (next_opcode & 0xFF00) == (0x7000 | (y << 8)))
+					{
+						row_offset += next_opcode & 0xFF;
+						continue;
+					}
+					if ((next.Size == 2 && (next_opcode & 0xF000) == 0xA000) || (next.Size == 4 && next_opcode == 0xF000))
+					{
+						if (IsExternal(next.Offset))
+						{
+							break;
+						}
+						current_address_value = (next.Size == 4) ? ((ProgramData[next.Offset + 2] << 8) | ProgramData[next.Offset + 3]) : (next_opcode & 0xFFF);
+						continue;
+					}
+					if (next.Size == 2 && (next_opcode & 0xFFF0) == (opcode & 0xFFF0) && row_offset == height && current_address_value == sprite_address + height && height + (next_opcode & 0xF) <= 0xF && RegisterValueList[y] + height + (next_opcode & 0xF) <= 32)
+					{
+						merge = j;
+					}
+					break;
+				}
+				bool flag_unused = false;
+				for (size_t k = merge + 1; merge != std::string::npos && k < instruction_count && IsContiguous(k); ++k)
+				{
+					unsigned short next_opcode = GetOpcode(InstructionLocationList[k]);
+					if (InstructionLocationList[k].Size == 2 && OverwritesFlag(next_opcode))
+					{
+						flag_unused = true;
+					}
+					if (!IgnoresFlag(next_opcode))
+					{
+						break;
+					}
+				}
+				if (flag_unused)
+				{
+					ProgramData[l.Offset + 1] = (ProgramData[l.Offset + 1] & 0xF0) | (height + (GetOpcode(InstructionLocationList[merge]) & 0xF));
+					EditList.push_back({ InstructionLocationList[merge].Offset, 2, {} });
+					address_known = false;
+					RegisterValueList.fill(-1);
+					changed = true;
+					i = merge;
+					continue;
+				}
+			}
+			if (l.Size == 2 && ((opcode & 0xF000) == 0x6000 || (opcode & 0xF00F) == 0x8000))
+			{
+				size_t x = (opcode >> 8) & 0xF;
+				size_t y = (opcode >> 4) & 0xF;
+				int value = ((opcode & 0xF000) == 0x6000) ? (opcode & 0xFF) : RegisterValueList[y];
+				bool redundant = ((opcode & 0xF000) == 0x8000 && x == y) || (value >= 0 && RegisterValueList[x] == value);
+				if (redundant && removable)
+				{
+					EditList.push_back({ l.Offset, l.Size, {} });
+					changed = true;
+					continue;
+				}
+				if (!redundant)
+				{
+					RegisterValueList[x] = after_skip ? -1 : value;
+				}
+				continue;
+			}
+			if (l.Size == 2)
+			{
+				std::array<int, 16> PreviousValueList = RegisterValueList;
+				TrackRegisters(opcode, RegisterValueList);
+				for (size_t r = 0; r < RegisterValueList.size() && after_skip; ++r)
+				{
+					if (RegisterValueList[r] != PreviousValueList[r])
+					{
+						RegisterValueList[r] = -1;
+					}
+				}
+			}
+			if (l.Size == 2 && EndsBasicBlock(opcode) && !IsSkipOpcode(opcode))
+			{
+				RegisterValueList.fill(-1);
+			}
+			if (l.Size != 2 || EndsBasicBlock(opcode) || !PreservesAddressRegister(opcode))
+			{
+				address_known = false;
+			}
+		}
+		if (EditList.size() > 0)
+		{
+			Relayout(EditList);
+		}
+		if (changed)
+		{
+			ResolveReferences();
+		}
+	}
+}
+
+void BandCHIP_Assembler::Assembler::EvaluateInitRegions()
+{
+	const size_t step_limit = 10000000;
+	for (size_t i = 0; i < InitList.size(); ++i)
+	{
+		size_t start = InitList[i].Offset;
+		size_t end = InitList[i].Offset + InitList[i].Size;
+		size_t line_number = InitList[i].LineNumber;
+		if (start == end)
+		{
+			continue;
+		}
+		auto FindInstruction = [this](size_t offset)
+		{
+			auto instruction = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), offset, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+			return instruction != InstructionLocationList.end() && instruction->Offset == offset;
+		};
+		if (!FindInstruction(start) || (end < ProgramData.size() && !FindInstruction(end)))
+		{
+			Log << "Keeping the INIT code at line " << line_number << ", since optimization moved code across its edges.\n";
+			continue;
+		}
+		bool entered = false;
+		for (auto &Reference : LabelReferenceList)
+		{
+			auto symbol = SymbolIndex.find(Reference.Name);
+			if ((Reference.Address < start || Reference.Address >= end) && symbol != SymbolIndex.end() && SymbolTable[symbol->second].Location >= 0x200 + start && SymbolTable[symbol->second].Location < 0x200 + end)
+			{
+				entered = true;
+				break;
+			}
+		}
+		std::vector<size_t> PinnedOffsetList = GetPinnedOffsetList();
+		auto pinned = std::lower_bound(PinnedOffsetList.begin(), PinnedOffsetList.end(), start);
+		if (entered || (pinned != PinnedOffsetList.end() && *pinned < end))
+		{
+			Log << "Keeping the INIT code at line " << line_number << ", since other code refers into it.\n";
+			continue;
+		}
+		Interpreter Machine(CurrentExtension, ProgramData, true);
+		Machine.Jump(static_cast<unsigned short>(0x200 + start));
+		size_t step_count = 0;
+		while ((Machine.GetProgramCounter() != 0x200 + end || Machine.GetStackDepth() > 0) && step_count < step_limit && Machine.Step())
+		{
+			++step_count;
+		}
+		std::stringstream error_message;
+		error_message << std::hex << std::uppercase << std::setfill('0');
+		switch (Machine.GetStatus())
+		{
+			case InterpreterStatus::Unsupported:
+			{
+				error_message << "INIT code reaches " << std::setw(4) << Machine.GetOpcode() << " at 0x" << std::setw(4) << Machine.GetProgramCounter() << ", which cannot run at assembly time.\n";
+				break;
+			}
+			case InterpreterStatus::UndefinedRead:
+			{
+				error_message << "INIT code reads a register at 0x" << std::setw(4) << Machine.GetProgramCounter() << " before setting it.\n";
+				break;
+			}
+			case InterpreterStatus::InvalidInstruction:
+			{
+				error_message << "INIT code reaches an invalid instruction (" << std::setw(4) << Machine.GetOpcode() << ") at 0x" << std::setw(4) << Machine.GetProgramCounter() << ".\n";
+				break;
+			}
+			case InterpreterStatus::StackFault:
+			{
+				error_message << "INIT code overflows or underflows the stack at 0x" << std::setw(4) << Machine.GetProgramCounter() << ".\n";
+				break;
+			}
+			default:
+			{
+				if (Machine.GetProgramCounter() != 0x200 + end || Machine.GetStackDepth() > 0)
+				{
+					error_message << "INIT code does not reach INIT_END within " << std::dec << step_limit << " instructions.\n";
+				}
+				break;
+			}
+		}
+		if (error_message.str().size() > 0)
+		{
+			++error_count;
+			Log << "Error at " << line_number << " : " << error_message.str();
+			DiagnosticList.push_back({ line_number, 0, error_message.str() });
+			continue;
+		}
+		std::vector<unsigned char> RestoreData;
+		std::vector<InstructionLocationData> RestoreInstructionList;
+		for (size_t r = 0; r < 16; ++r)
+		{
+			if (Machine.IsRegisterSet(r))
+			{
+				RestoreInstructionList.push_back({ RestoreData.size(), 2, line_number });
+				RestoreData.push_back(0x60 | r);
+				RestoreData.push_back(Machine.GetRegisterList()[r]);
+			}
+		}
+		if (Machine.IsAddressRegisterSet())
+		{
+			unsigned short address = Machine.GetAddressRegister();
+			if (address <= 0xFFF)
+			{
+				RestoreInstructionList.push_back({ RestoreData.size(), 2, line_number });
+				RestoreData.push_back(0xA0 | (address >> 8));
+				RestoreData.push_back(address & 0xFF);
+			}
+			else if (CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64)
+			{
+				RestoreInstructionList.push_back({ RestoreData.size(), 4, line_number });
+				RestoreData.insert(RestoreData.end(), { 0xF0, 0x00, static_cast<unsigned char>(address >> 8), static_cast<unsigned char>(address & 0xFF) });
+			}
+			else
+			{
+				Log << "Keeping the INIT code at line " << line_number << ", since it leaves the I register past 0xFFF.\n";
+				continue;
+			}
+		}
+		if (RestoreData.size() < end - start)
+		{
+			if (0x200 + end > 0xFFF)
+			{
+				Log << "Keeping the INIT code at line " << line_number << ", since the code after it is out of reach of JP.\n";
+				continue;
+			}
+			RestoreInstructionList.push_back({ RestoreData.size(), 2, line_number });
+			RestoreData.push_back(0x10 | ((0x200 + end) >> 8));
+			RestoreData.push_back((0x200 + end) & 0xFF);
+		}
+		if (RestoreData.size() > end - start)
+		{
+			Log << "Keeping the INIT code at line " << line_number << ", since setting up its registers takes more room than the code itself.\n";
+			continue;
+		}
+		const std::vector<unsigned char> &Memory = Machine.GetMemory();
+		if (std::find_if(Memory.begin(), Memory.begin() + 0x200, [](unsigned char value) { return value != 0x00; }) != Memory.begin() + 0x200)
+		{
+			++error_count;
+			Log << "Error at " << line_number << " : INIT code writes below 0x200.\n";
+			DiagnosticList.push_back({ line_number, 0, "INIT code writes below 0x200.\n" });
+			continue;
+		}
+		if (!std::equal(Memory.begin() + 0x200 + start, Memory.begin() + 0x200 + start + RestoreData.size(), ProgramData.begin() + start))
+		{
+			Log << "Keeping the INIT code at line " << line_number << ", since it writes over its own first instructions.\n";
+			continue;
+		}
+		size_t image_size = ProgramData.size();
+		for (size_t a = Memory.size(); a > 0x200 + image_size; --a)
+		{
+			if (Memory[a - 1] != 0x00)
+			{
+				image_size = a - 0x200;
+				break;
+			}
+		}
+		ProgramData.resize(image_size, 0x00);
+		size_t changed_count = 0;
+		for (size_t offset = 0; offset < ProgramData.size(); ++offset)
+		{
+			if ((offset < start || offset >= end) && ProgramData[offset] != Memory[0x200 + offset])
+			{
+				ProgramData[offset] = Memory[0x200 + offset];
+				++changed_count;
+			}
+		}
+		std::vector<unsigned char> RegionData(Memory.begin() + 0x200 + start, Memory.begin() + 0x200 + end);
+		std::copy(RestoreData.begin(), RestoreData.end(), RegionData.begin());
+		std::vector<RelayoutData> EditList = { { start, end - start, RegionData, {}, RestoreInstructionList } };
+		Relayout(EditList);
+		Log << "Ran the INIT code at line " << line_number << " in " << step_count << " instruction" << ((step_count != 1) ? "s" : "") << ", changing " << changed_count << " byte" << ((changed_count != 1) ? "s" : "") << " outside of it.\n";
+	}
+}
+
+size_t BandCHIP_Assembler::Assembler::GetErrorCount() const
+{
+	return error_count;
+}
+
+const std::vector<unsigned char> &BandCHIP_Assembler::Assembler::GetProgramData() const
+{
+	return ProgramData;
+}
+
+std::vector<unsigned char> BandCHIP_Assembler::Assembler::GetOutputData() const
+{
+	if (object_mode)
+	{
+		return WriteObject(GetObject());
+	}
+	switch (CurrentOutputType)
+	{
+		case OutputType::HexASCIIString:
+		{
+			std::ostringstream hex_data;
+			hex_data << std::hex;
+			for (size_t c = 0; c < ProgramData.size(); ++c)
+			{
+				hex_data << std::setfill('0') << std::setw(2) << static_cast<unsigned short>(ProgramData[c]);
+			}
+			std::string hex_str = hex_data.str();
+			return std::vector<unsigned char>(hex_str.begin(), hex_str.end());
+		}
+		default:
+		{
+			return ProgramData;
+		}
+	}
+}
+
+const std::vector<std::string> &BandCHIP_Assembler::Assembler::GetDependencyList() const
+{
+	return DependencyList;
+}
+
+const std::vector<BandCHIP_Assembler::Symbol> &BandCHIP_Assembler::Assembler::GetSymbolTable() const
+{
+	return SymbolTable;
+}
+
+const std::vector<BandCHIP_Assembler::UnresolvedReferenceData> &BandCHIP_Assembler::Assembler::GetLabelReferenceList() const
+{
+	return LabelReferenceList;
+}
+
+const std::vector<BandCHIP_Assembler::DiagnosticData> &BandCHIP_Assembler::Assembler::GetDiagnosticList() const
+{
+	return DiagnosticList;
+}
+
+const std::vector<BandCHIP_Assembler::InstructionLocationData> &BandCHIP_Assembler::Assembler::GetInstructionLocationList() const
+{
+	return InstructionLocationList;
+}
+
+BandCHIP_Assembler::ObjectData BandCHIP_Assembler::Assembler::GetObject() const
+{
+	return { CurrentExtension, CurrentOutputType, align, origin_used, ProgramData, SymbolTable, LabelReferenceList };
+}
+
+std::string BandCHIP_Assembler::Assembler::GetListing() const
+{
+	std::ostringstream listing;
+	TimingType timing = GetTiming();
+	size_t previous_line = 0;
+	auto AddRow = [this, &listing](size_t offset, size_t size, const std::string &cycles, size_t line_number, const std::string &source)
+	{
+		std::ostringstream row;
+		row << "0x" << std::hex << std::uppercase << std::setfill('0') << std::setw(4) << (0x200 + offset) << "   ";
+		for (size_t b = 0; b < 4; ++b)
+		{
+			if (b < size)
+			{
+				row << std::setw(2) << static_cast<unsigned int>(ProgramData[offset + b]) << ' ';
+			}
+			else
+			{
+				row << "   ";
+			}
+		}
+		row << std::dec << std::setfill(' ') << std::left << "  " << std::setw(12) << cycles;
+		if (line_number != 0)
+		{
+			row << std::setw(7) << line_number << source;
+		}
+		std::string text = row.str();
+		text.erase(text.find_last_not_of(' ') + 1);
+		listing << text << '\n';
+	};
+	listing << "Address  Bytes         Cycles      Line   Source\n";
+	size_t offset = 0;
+	size_t r = 0;
+	while (offset < ProgramData.size())
+	{
+		if (r < InstructionLocationList.size() && InstructionLocationList[r].Offset < offset)
+		{
+			++r;
+			continue;
+		}
+		size_t next = (r < InstructionLocationList.size()) ? InstructionLocationList[r].Offset : ProgramData.size();
+		if (next != offset)
+		{
+			size_t size = std::min<size_t>(next - offset, 4);
+			AddRow(offset, size, "", 0, "");
+			offset += size;
+			continue;
+		}
+		const InstructionLocationData &l = InstructionLocationList[r];
+		unsigned short opcode = (ProgramData[l.Offset] << 8) | ProgramData[l.Offset + 1];
+		size_t minimum = 0;
+		size_t maximum = 0;
+		std::string cycles = "wait";
+		if (GetCycleCost(timing, opcode, minimum, maximum))
+		{
+			cycles = std::to_string(minimum);
+			if (maximum != minimum)
+			{
+				cycles += '-' + std::to_string(maximum);
+			}
+		}
+		std::string source = (l.LineNumber != previous_line && l.LineNumber > 0 && l.LineNumber <= SourceLineList.size()) ? SourceLineList[l.LineNumber - 1] : "";
+		previous_line = l.LineNumber;
+		AddRow(offset, l.Size, cycles, l.LineNumber, source);
+		offset += l.Size;
+		++r;
+	}
+	return listing.str();
+}
+
+BandCHIP_Assembler::TimingType BandCHIP_Assembler::Assembler::GetTiming() const
+{
+	if (CurrentTiming != TimingType::Automatic)
+	{
+		return CurrentTiming;
+	}
+	switch (CurrentExtension)
+	{
+		case ExtensionType::CHIP8:
+		{
+			return TimingType::VIP;
+		}
+		case ExtensionType::SuperCHIP10:
+		case ExtensionType::SuperCHIP11:
+		{
+			return TimingType::SuperCHIP;
+		}
+		default:
+		{
+			return TimingType::XOCHIP;
+		}
+	}
+}
+
+bool BandCHIP_Assembler::Assembler::MeasureCycles(size_t offset, size_t depth, size_t &cycles) const
+{
+	if (depth > 16)
+	{
+		return false;
+	}
+	TimingType timing = GetTiming();
+	size_t start = offset;
+	bool conditional = false;
+	auto l = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), offset, [](const InstructionLocationData &location, size_t o) { return location.Offset < o; });
+	for (; l != InstructionLocationList.end() && l->Offset == offset; ++l)
+	{
+		unsigned short opcode = (ProgramData[l->Offset] << 8) | ProgramData[l->Offset + 1];
+		size_t minimum = 0;
+		size_t maximum = 0;
+		if (!GetCycleCost(timing, opcode, minimum, maximum))
+		{
+			return false;
+		}
+		cycles += maximum;
+		if ((opcode & 0xF000) == 0x2000)
+		{
+			if ((opcode & 0xFFF) < 0x200 || !MeasureCycles((opcode & 0xFFF) - 0x200, depth + 1, cycles))
+			{
+				return false;
+			}
+		}
+		else if (CurrentExtension == ExtensionType::HyperCHIP64 && (opcode & 0xF0FF) == 0xF021)
+		{
+			return false;
+		}
+		else if ((!conditional && !IsSkipOpcode(opcode) && EndsBasicBlock(opcode)) || opcode == (0x1200 + start))
+		{
+			return true;
+		}
+		conditional = IsSkipOpcode(opcode);
+		offset += l->Size;
+	}
+	return false;
+}
+
+void BandCHIP_Assembler::Assembler::CheckCycleAssertions()
+{
+	for (auto &a : CycleAssertionList)
+	{
+		auto symbol = SymbolIndex.find(a.Name);
+		size_t cycles = 0;
+		if (symbol == SymbolIndex.end() || SymbolTable[symbol->second].Location < 0x200 || !MeasureCycles(SymbolTable[symbol->second].Location - 0x200, 0, cycles))
+		{
+			++error_count;
+			Log << "Error at " << a.LineNumber << " : Unable to measure the cycles of '" << a.Name << "'.\n";
+			DiagnosticList.push_back({ a.LineNumber, 0, "Unable to measure the cycles of '" + a.Name + "'.\n" });
+		}
+		else if (cycles > a.Maximum)
+		{
+			++error_count;
+			Log << "Error at " << a.LineNumber << " : '" << a.Name << "' takes up to " << cycles << " cycles, which exceeds its budget of " << a.Maximum << ".\n";
+			DiagnosticList.push_back({ a.LineNumber, 0, "'" + a.Name + "' takes up to " + std::to_string(cycles) + " cycles, which exceeds its budget of " + std::to_string(a.Maximum) + ".\n" });
+		}
+	}
+}
+
+std::vector<BandCHIP_Assembler::BasicBlockData> BandCHIP_Assembler::Assembler::GetBasicBlockList() const
+{
+	size_t instruction_count = InstructionLocationList.size();
+	bool indirect = (CurrentExtension == ExtensionType::HyperCHIP64);
+	auto FindInstruction = [this](size_t offset)
+	{
+		auto instruction = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), offset, [](const InstructionLocationData &l, size_t value) { return l.Offset < value; });
+		return (instruction != InstructionLocationList.end() && instruction->Offset == offset) ? static_cast<size_t>(instruction - InstructionLocationList.begin()) : std::string::npos;
+	};
+	auto GetOpcode = [this](size_t i)
+	{
+		return static_cast<unsigned short>((ProgramData[InstructionLocationList[i].Offset] << 8) | ProgramData[InstructionLocationList[i].Offset + 1]);
+	};
+	std::unordered_map<size_t, size_t> DataReferenceIndex;
+	for (size_t r = 0; r < LabelReferenceList.size(); ++r)
+	{
+		if (!LabelReferenceList[r].IsInstruction)
+		{
+			DataReferenceIndex[LabelReferenceList[r].Address] = r;
+		}
+	}
+	std::vector<bool> LabelList(ProgramData.size() + 1, false);
+	for (auto &s : SymbolTable)
+	{
+		if (s.Location >= 0x200 && s.Location - 0x200 <= ProgramData.size())
+		{
+			LabelList[s.Location - 0x200] = true;
+		}
+	}
+	auto GetTargetList = [this, instruction_count, indirect, &FindInstruction, &GetOpcode, &DataReferenceIndex, &LabelList](size_t i)
+	{
+		std::vector<size_t> TargetList;
+		unsigned short opcode = GetOpcode(i);
+		size_t target = opcode & 0xFFF;
+		if (InstructionLocationList[i].Size != 2)
+		{
+			return TargetList;
+		}
+		if (((opcode & 0xF000) == 0x1000 || (opcode & 0xF000) == 0x2000) && target >= 0x200)
+		{
+			TargetList.push_back(target - 0x200);
+		}
+		else if ((opcode & 0xF000) == 0xB000 && target >= 0x200)
+		{
+			for (size_t t = FindInstruction(target - 0x200); t < instruction_count; ++t)
+			{
+				const InstructionLocationData &entry = InstructionLocationList[t];
+				TargetList.push_back(entry.Offset);
+				if (entry.Size != 2 || (GetOpcode(t) & 0xF000) != 0x1000 || t + 1 >= instruction_count || entry.Offset + entry.Size != InstructionLocationList[t + 1].Offset || LabelList[entry.Offset + entry.Size])
+				{
+					break;
+				}
+			}
+		}
+		else if (indirect && ((opcode & 0xF0FF) == 0xF020 || (opcode & 0xF0FF) == 0xF021))
+		{
+			size_t table = 0;
+			for (size_t p = i; p > 0; --p)
+			{
+				const InstructionLocationData &previous = InstructionLocationList[p - 1];
+				unsigned short previous_opcode = GetOpcode(p - 1);
+				if (previous.Offset + previous.Size != InstructionLocationList[p].Offset)
+				{
+					break;
+				}
+				if ((previous_opcode & 0xF000) == 0xA000 || (previous.Size == 4 && previous_opcode == 0xF000))
+				{
+					table = (previous.Size == 4) ? ((ProgramData[previous.Offset + 2] << 8) | ProgramData[previous.Offset + 3]) : (previous_opcode & 0xFFF);
+					break;
+				}
+				if (EndsBasicBlock(previous_opcode) || (!PreservesAddressRegister(previous_opcode) && (previous_opcode & 0xF0FF) != 0xF01E))
+				{
+					break;
+				}
+			}
+			for (size_t entry = table - 0x200; table >= 0x200 && DataReferenceIndex.find(entry) != DataReferenceIndex.end(); entry += 2)
+			{
+				auto symbol = SymbolIndex.find(LabelReferenceList[DataReferenceIndex.find(entry)->second].Name);
+				if (symbol == SymbolIndex.end() || SymbolTable[symbol->second].Location < 0x200)
+				{
+					break;
+				}
+				TargetList.push_back(SymbolTable[symbol->second].Location - 0x200);
+			}
+		}
+		return TargetList;
+	};
+	auto GetExit = [indirect](unsigned short opcode)
+	{
+		if (IsSkipOpcode(opcode))
+		{
+			return BlockExitType::Skip;
+		}
+		switch (opcode & 0xF000)
+		{
+			case 0x0000:
+			{
+				return (opcode == 0x00EE) ? BlockExitType::Return : (opcode == 0x00FD) ? BlockExitType::Exit : BlockExitType::FallThrough;
+			}
+			case 0x1000:
+			{
+				return BlockExitType::Jump;
+			}
+			case 0x2000:
+			{
+				return BlockExitType::Call;
+			}
+			case 0xB000:
+			{
+				return BlockExitType::IndirectJump;
+			}
+			case 0xF000:
+			{
+				if (indirect && (opcode & 0xFF) == 0x20)
+				{
+					return BlockExitType::IndirectJump;
+				}
+				if (indirect && (opcode & 0xFF) == 0x21)
+				{
+					return BlockExitType::IndirectCall;
+				}
+				break;
+			}
+		}
+		return BlockExitType::FallThrough;
+	};
+	std::vector<bool> ReachedList(instruction_count, false);
+	std::vector<bool> LeaderList(instruction_count, false);
+	std::vector<size_t> WorkList;
+	auto Mark = [&FindInstruction, &ReachedList, &LeaderList, &WorkList](size_t offset, bool leader)
+	{
+		size_t i = FindInstruction(offset);
+		if (i == std::string::npos)
+		{
+			return;
+		}
+		LeaderList[i] = LeaderList[i] || leader;
+		if (!ReachedList[i])
+		{
+			ReachedList[i] = true;
+			WorkList.push_back(i);
+		}
+	};
+	Mark(0, true);
+	if (object_mode)
+	{
+		for (auto &s : SymbolTable)
+		{
+			if (s.Location >= 0x200)
+			{
+				Mark(s.Location - 0x200, true);
+			}
+		}
+	}
+	while (WorkList.size() > 0)
+	{
+		size_t i = WorkList.back();
+		WorkList.pop_back();
+		size_t next = InstructionLocationList[i].Offset + InstructionLocationList[i].Size;
+		BlockExitType exit = (InstructionLocationList[i].Size == 2) ? GetExit(GetOpcode(i)) : BlockExitType::FallThrough;
+		for (auto t : GetTargetList(i))
+		{
+			Mark(t, true);
+		}
+		if (exit == BlockExitType::Skip)
+		{
+			size_t skipped = FindInstruction(next);
+			Mark(next, true);
+			if (skipped != std::string::npos)
+			{
+				Mark(next + InstructionLocationList[skipped].Size, true);
+			}
+		}
+		else if (exit == BlockExitType::Call || exit == BlockExitType::IndirectCall)
+		{
+			Mark(next, true);
+		}
+		else if (exit == BlockExitType::FallThrough)
+		{
+			Mark(next, false);
+		}
+	}
+	std::vector<BasicBlockData> BlockList;
+	for (size_t i = 0; i < instruction_count; ++i)
+	{
+		if (!ReachedList[i] || !LeaderList[i])
+		{
+			continue;
+		}
+		BasicBlockData Block = { InstructionLocationList[i].Offset, 0, BlockExitType::Halt, {} };
+		for (size_t j = i; j < instruction_count; ++j)
+		{
+			const InstructionLocationData &l = InstructionLocationList[j];
+			size_t next = l.Offset + l.Size;
+			Block.Size = next - Block.Offset;
+			Block.Exit = (l.Size == 2) ? GetExit(GetOpcode(j)) : BlockExitType::FallThrough;
+			Block.SuccessorList = GetTargetList(j);
+			if (Block.Exit == BlockExitType::Skip)
+			{
+				size_t skipped = FindInstruction(next);
+				Block.SuccessorList.push_back(next);
+				if (skipped != std::string::npos)
+				{
+					Block.SuccessorList.push_back(next + InstructionLocationList[skipped].Size);
+				}
+			}
+			else if (Block.Exit == BlockExitType::Call || Block.Exit == BlockExitType::IndirectCall)
+			{
+				Block.SuccessorList.push_back(next);
+			}
+			if (Block.Exit != BlockExitType::FallThrough)
+			{
+				break;
+			}
+			if (j + 1 >= instruction_count || InstructionLocationList[j + 1].Offset != next)
+			{
+				Block.Exit = BlockExitType::Halt;
+				break;
+			}
+			if (LeaderList[j + 1])
+			{
+				Block.SuccessorList.push_back(next);
+				break;
+			}
+		}
+		BlockList.push_back(std::move(Block));
+	}
+	return BlockList;
+}
+
+std::string BandCHIP_Assembler::Assembler::GetControlFlowGraph() const
+{
+	static const std::array<std::string, 9> ExitNameList = {
+		"fall through", "jump", "call", "skip", "return", "indirect jump", "indirect call", "exit", "halt"
+	};
+	std::unordered_map<size_t, std::string> LabelIndex;
+	for (auto &s : SymbolTable)
+	{
+		LabelIndex.emplace(s.Location - 0x200, s.Name);
+	}
+	auto GetNodeName = [](size_t offset)
+	{
+		std::ostringstream name;
+		name << "\"0x" << std::hex << std::uppercase << std::setfill('0') << std::setw(4) << (0x200 + offset) << '"';
+		return name.str();
+	};
+	std::ostringstream graph;
+	graph << "digraph program\n{\n\tnode [shape=box, fontname=\"monospace\"];\n";
+	for (auto &b : GetBasicBlockList())
+	{
+		auto label = LabelIndex.find(b.Offset);
+		graph << '\t' << GetNodeName(b.Offset) << " [label=\"" << ((label != LabelIndex.end()) ? label->second + "\\n" : "") << GetNodeName(b.Offset).substr(1, 6) << " (" << b.Size << " bytes)\\n" << ExitNameList[static_cast<size_t>(b.Exit)] << "\"];\n";
+		for (size_t s = 0; s < b.SuccessorList.size(); ++s)
+		{
+			graph << '\t' << GetNodeName(b.Offset) << " -> " << GetNodeName(b.SuccessorList[s]);
+			bool last = (s + 1 == b.SuccessorList.size());
+			if ((b.Exit == BlockExitType::Call || b.Exit == BlockExitType::IndirectCall) && !last)
+			{
+				graph << " [style=dashed, label=\"call\"]";
+			}
+			else if ((b.Exit == BlockExitType::Call || b.Exit == BlockExitType::IndirectCall) && last)
+			{
+				graph << " [label=\"return\"]";
+			}
+			else if (b.Exit == BlockExitType::Skip && s == 1)
+			{
+				graph << " [label=\"skip\"]";
+			}
+			graph << ";\n";
+		}
+	}
+	graph << "}\n";
+	return graph.str();
+}
+
+std::vector<std::pair<size_t, size_t>> BandCHIP_Assembler::Assembler::GetWriteRangeList() const
+{
+	typedef std::array<std::pair<size_t, size_t>, 17> RangeState;
+	const size_t address_register = 16;
+	std::vector<std::pair<size_t, size_t>> WriteRangeList;
+	std::vector<BasicBlockData> BlockList = GetBasicBlockList();
+	bool complete = !object_mode;
+	for (auto &b : BlockList)
+	{
+		if (b.Exit == BlockExitType::Halt || ((b.Exit == BlockExitType::IndirectJump || b.Exit == BlockExitType::IndirectCall) && b.SuccessorList.size() <= ((b.Exit == BlockExitType::IndirectCall) ? 1 : 0)))
+		{
+			complete = false;
+		}
+	}
+	if (!complete)
+	{
+		WriteRangeList.push_back({ 0x0000, 0xFFFF });
+		return WriteRangeList;
+	}
+	RangeState Unknown;
+	Unknown.fill({ 0x00, 0xFF });
+	Unknown[address_register] = { 0x0000, 0xFFFF };
+	bool increments = (CurrentExtension != ExtensionType::SuperCHIP10 && CurrentExtension != ExtensionType::SuperCHIP11);
+	auto Transfer = [this, address_register, increments, &Unknown](size_t offset, size_t size, RangeState &State, std::vector<std::pair<size_t, size_t>> *StoreList)
+	{
+		unsigned short opcode = (ProgramData[offset] << 8) | ProgramData[offset + 1];
+		size_t x = (opcode >> 8) & 0xF;
+		size_t y = (opcode >> 4) & 0xF;
+		size_t nn = opcode & 0xFF;
+		std::pair<size_t, size_t> &I = State[address_register];
+		auto Store = [&I, StoreList](size_t length)
+		{
+			if (StoreList != nullptr)
+			{
+				StoreList->push_back({ I.first, std::min<size_t>(I.second + length - 1, 0xFFFF) });
+			}
+		};
+		auto AddToI = [&I, &Unknown, address_register](size_t minimum, size_t maximum)
+		{
+			I = (I.second + maximum <= 0xFFFF) ? std::make_pair(I.first + minimum, I.second + maximum) : Unknown[address_register];
+		};
+		if (size == 4)
+		{
+			I.first = I.second = (ProgramData[offset + 2] << 8) | ProgramData[offset + 3];
+			return;
+		}
+		switch (opcode & 0xF000)
+		{
+			case 0x5000:
+			{
+				if ((opcode & 0xF) == 0x2)
+				{
+					Store(((x > y) ? x - y : y - x) + 1);
+				}
+				else if ((opcode & 0xF) == 0x3)
+				{
+					for (size_t r = std::min(x, y); r <= std::max(x, y); ++r)
+					{
+						State[r] = Unknown[r];
+					}
+				}
+				break;
+			}
+			case 0x6000:
+			{
+				State[x] = { nn, nn };
+				break;
+			}
+			case 0x7000:
+			{
+				State[x] = (State[x].second + nn <= 0xFF) ? std::make_pair(State[x].first + nn, State[x].second + nn) : Unknown[x];
+				break;
+			}
+			case 0x8000:
+			{
+				switch (opcode & 0xF)
+				{
+					case 0x0:
+					{
+						State[x] = State[y];
+						break;
+					}
+					case 0x2:
+					{
+						State[x] = { 0x00, std::min(State[x].second, State[y].second) };
+						State[0xF] = Unknown[0xF];
+						break;
+					}
+					case 0xA:
+					{
+						State[0xF] = Unknown[0xF];
+						break;
+					}
+					default:
+					{
+						State[x] = Unknown[x];
+						State[0xF] = Unknown[0xF];
+						break;
+					}
+				}
+				break;
+			}
+			case 0xA000:
+			{
+				I.first = I.second = opcode & 0xFFF;
+				break;
+			}
+			case 0xC000:
+			{
+				State[x] = { 0x00, nn };
+				break;
+			}
+			case 0xD000:
+			{
+				State[0xF] = Unknown[0xF];
+				break;
+			}
+			case 0xF000:
+			{
+				switch (nn)
+				{
+					case 0x07:
+					case 0x0A:
+					{
+						State[x] = Unknown[x];
+						break;
+					}
+					case 0x1E:
+					{
+						AddToI(State[x].first, State[x].second);
+						break;
+					}
+					case 0x29:
+					case 0x30:
+					{
+						I = { 0x000, 0x1FF };
+						break;
+					}
+					case 0x33:
+					{
+						Store(3);
+						break;
+					}
+					case 0x55:
+					{
+						Store(x + 1);
+						AddToI(increments ? x + 1 : 0, x + 1);
+						break;
+					}
+					case 0x65:
+					case 0x85:
+					{
+						for (size_t r = 0; r <= x; ++r)
+						{
+							State[r] = Unknown[r];
+						}
+						if (nn == 0x65)
+						{
+							AddToI(increments ? x + 1 : 0, x + 1);
+						}
+						break;
+					}
+					case 0xA2:
+					{
+						I = Unknown[address_register];
+						break;
+					}
+				}
+				break;
+			}
+		}
+	};
+	auto RunBlock = [this, &Transfer](const BasicBlockData &Block, RangeState State, std::vector<std::pair<size_t, size_t>> *StoreList)
+	{
+		auto l = std::lower_bound(InstructionLocationList.begin(), InstructionLocationList.end(), Block.Offset, [](const InstructionLocationData &location, size_t value) { return location.Offset < value; });
+		for (; l != InstructionLocationList.end() && l->Offset < Block.Offset + Block.Size; ++l)
+		{
+			Transfer(l->Offset, l->Size, State, StoreList);
+		}
+		return State;
+	};
+	std::unordered_map<size_t, size_t> BlockIndex;
+	for (size_t b = 0; b < BlockList.size(); ++b)
+	{
+		BlockIndex[BlockList[b].Offset] = b;
+	}
+	std::vector<RangeState> EntryStateList(BlockList.size(), Unknown);
+	std::vector<bool> VisitedList(BlockList.size(), false);
+	std::vector<size_t> UpdateCountList(BlockList.size(), 0);
+	std::vector<size_t> WorkList;
+	auto Merge = [&EntryStateList, &VisitedList, &UpdateCountList, &WorkList, &Unknown](size_t b, const RangeState &State)
+	{
+		RangeState Merged = State;
+		if (VisitedList[b])
+		{
+			for (size_t r = 0; r < Merged.size(); ++r)
+			{
+				Merged[r] = { std::min(Merged[r].first, EntryStateList[b][r].first), std::max(Merged[r].second, EntryStateList[b][r].second) };
+				if (UpdateCountList[b] >= 8 && Merged[r] != EntryStateList[b][r])
+				{
+					Merged[r] = Unknown[r];
+				}
+			}
+			if (Merged == EntryStateList[b])
+			{
+				return;
+			}
+		}
+		VisitedList[b] = true;
+		EntryStateList[b] = Merged;
+		++UpdateCountList[b];
+		WorkList.push_back(b);
+	};
+	if (BlockList.size() > 0)
+	{
+		Merge(0, Unknown);
+	}
+	while (WorkList.size() > 0)
+	{
+		size_t b = WorkList.back();
+		WorkList.pop_back();
+		RangeState State = RunBlock(BlockList[b], EntryStateList[b], nullptr);
+		bool call = (BlockList[b].Exit == BlockExitType::Call || BlockList[b].Exit == BlockExitType::IndirectCall);
+		for (size_t s = 0; s < BlockList[b].SuccessorList.size(); ++s)
+		{
+			auto successor = BlockIndex.find(BlockList[b].SuccessorList[s]);
+			if (successor != BlockIndex.end())
+			{
+				Merge(successor->second, (call && s + 1 == BlockList[b].SuccessorList.size()) ? Unknown : State);
+			}
+		}
+	}
+	for (size_t b = 0; b < BlockList.size(); ++b)
+	{
+		if (VisitedList[b])
+		{
+			RunBlock(BlockList[b], EntryStateList[b], &WriteRangeList);
+		}
+	}
+	return WriteRangeList;
+}
+
+std::string BandCHIP_Assembler::Assembler::RunProgram(unsigned long long cycle_limit) const
+{
+	TimingType timing = GetTiming();
+	unsigned long long frame_cycles = (timing == TimingType::VIP) ? 3668 : ((timing == TimingType::SuperCHIP) ? 30 : 1000);
+	Interpreter Machine(CurrentExtension, ProgramData, false);
+	std::vector<unsigned long long> InstructionCountList(Machine.GetMemory().size(), 0);
+	std::vector<unsigned long long> CycleCountList(Machine.GetMemory().size(), 0);
+	std::map<std::pair<unsigned short, unsigned short>, unsigned long long> LoopList;
+	unsigned long long cycles = 0;
+	unsigned long long instruction_count = 0;
+	unsigned long long frame_count = 0;
+	unsigned long long frame_position = 0;
+	while (cycles < cycle_limit)
+	{
+		unsigned short address = Machine.GetProgramCounter();
+		unsigned short opcode = Machine.GetOpcode();
+		if (!Machine.Step())
+		{
+			break;
+		}
+		size_t minimum = 0;
+		size_t maximum = 0;
+		GetCycleCost(timing, opcode, minimum, maximum);
+		size_t cost = (minimum + maximum) / 2;
+		++InstructionCountList[address];
+		CycleCountList[address] += cost;
+		++instruction_count;
+		cycles += cost;
+		bool jump = ((opcode & 0xF000) == 0x1000 || (opcode & 0xF000) == 0xB000 || (CurrentExtension == ExtensionType::HyperCHIP64 && (opcode & 0xF0FF) == 0xF020));
+		if (jump && Machine.GetProgramCounter() <= address)
+		{
+			++LoopList[{ Machine.GetProgramCounter(), address }];
+		}
+		for (frame_position += cost; frame_position >= frame_cycles; frame_position -= frame_cycles)
+		{
+			Machine.TickTimers();
+			++frame_count;
+		}
+	}
+	std::vector<std::pair<size_t, std::string>> LabelList;
+	for (auto &s : SymbolTable)
+	{
+		LabelList.push_back({ s.Location, s.Name });
+	}
+	std::sort(LabelList.begin(), LabelList.end());
+	auto GetLabel = [&LabelList](size_t address)
+	{
+		auto label = std::upper_bound(LabelList.begin(), LabelList.end(), std::make_pair(address, std::string(1, '\x7F')));
+		if (label == LabelList.begin())
+		{
+			return std::make_pair(static_cast<size_t>(0), std::string("(none)"));
+		}
+		return *(label - 1);
+	};
+	auto FormatAddress = [](size_t address)
+	{
+		std::ostringstream text;
+		text << "0x" << std::hex << std::uppercase << std::setfill('0') << std::setw(4) << address;
+		return text.str();
+	};
+	std::ostringstream report;
+	report << "Ran " << instruction_count << " instruction" << ((instruction_count != 1) ? "s" : "") << " in " << cycles << " cycle" << ((cycles != 1) ? "s" : "") << " (" << frame_count << " frame" << ((frame_count != 1) ? "s" : "") << "), stopping ";
+	switch (Machine.GetStatus())
+	{
+		case InterpreterStatus::Running:
+		{
+			report << "at the cycle limit.\n";
+			break;
+		}
+		case InterpreterStatus::Waiting:
+		{
+			report << "to wait for a key at " << FormatAddress(Machine.GetProgramCounter()) << ".\n";
+			break;
+		}
+		case InterpreterStatus::Exited:
+		{
+			report << "at EXIT at " << FormatAddress(Machine.GetProgramCounter()) << ".\n";
+			break;
+		}
+		case InterpreterStatus::StackFault:
+		{
+			report << "on a stack overflow or underflow at " << FormatAddress(Machine.GetProgramCounter()) << ".\n";
+			break;
+		}
+		default:
+		{
+			report << "on an invalid instruction (" << FormatAddress(Machine.GetOpcode()).substr(2) << ") at " << FormatAddress(Machine.GetProgramCounter()) << ".\n";
+			break;
+		}
+	}
+	std::map<std::string, std::pair<unsigned long long, unsigned long long>> LabelCountIndex;
+	for (size_t a = 0; a < InstructionCountList.size(); ++a)
+	{
+		if (InstructionCountList[a] > 0)
+		{
+			auto &count = LabelCountIndex[GetLabel(a).second];
+			count.first += InstructionCountList[a];
+			count.second += CycleCountList[a];
+		}
+	}
+	std::vector<std::pair<std::string, std::pair<unsigned long long, unsigned long long>>> LabelCountList(LabelCountIndex.begin(), LabelCountIndex.end());
+	std::stable_sort(LabelCountList.begin(), LabelCountList.end(), [](const std::pair<std::string, std::pair<unsigned long long, unsigned long long>> &a, const std::pair<std::string, std::pair<unsigned long long, unsigned long long>> &b) { return a.second.second > b.second.second; });
+	report << "\nLabel                   Instructions        Cycles   Share\n";
+	for (auto &l : LabelCountList)
+	{
+		double share = (cycles > 0) ? (100.0 * l.second.second / cycles) : 0.0;
+		report << std::left << std::setw(24) << l.first << std::right << std::setw(12) << l.second.first << std::setw(14) << l.second.second << std::setw(7) << std::fixed << std::setprecision(1) << share << "%\n";
+	}
+	std::vector<std::pair<std::pair<unsigned short, unsigned short>, unsigned long long>> HotLoopList(LoopList.begin(), LoopList.end());
+	auto GetLoopCycles = [&CycleCountList](const std::pair<unsigned short, unsigned short> &loop)
+	{
+		unsigned long long loop_cycles = 0;
+		for (size_t a = loop.first; a <= loop.second; ++a)
+		{
+			loop_cycles += CycleCountList[a];
+		}
+		return loop_cycles;
+	};
+	std::stable_sort(HotLoopList.begin(), HotLoopList.end(), [&GetLoopCycles](const std::pair<std::pair<unsigned short, unsigned short>, unsigned long long> &a, const std::pair<std::pair<unsigned short, unsigned short>, unsigned long long> &b) { return GetLoopCycles(a.first) > GetLoopCycles(b.first); });
+	if (HotLoopList.size() > 5)
+	{
+		HotLoopList.resize(5);
+	}
+	if (HotLoopList.size() > 0)
+	{
+		report << "\nLoop                    Start    End        Iterations        Cycles\n";
+	}
+	for (auto &l : HotLoopList)
+	{
+		auto label = GetLabel(l.first.first);
+		std::string name = label.second;
+		if (label.first != l.first.first && name != "(none)")
+		{
+			std::ostringstream offset;
+			offset << '+' << (l.first.first - label.first);
+			name += offset.str();
+		}
+		report << std::left << std::setw(24) << name << std::setw(9) << FormatAddress(l.first.first) << std::setw(9) << FormatAddress(l.first.second) << std::right << std::setw(12) << l.second << std::setw(14) << GetLoopCycles(l.first) << '\n';
+	}
+	report << "\nRegisters\n" << std::hex << std::uppercase << std::setfill('0');
+	for (size_t r = 0; r < 16; ++r)
+	{
+		report << 'V' << r << '=' << std::setw(2) << static_cast<unsigned int>(Machine.GetRegisterList()[r]) << (((r % 8) == 7) ? '\n' : ' ');
+	}
+	report << "I=" << std::setw(4) << Machine.GetAddressRegister() << " PC=" << std::setw(4) << Machine.GetProgramCounter() << " DT=" << std::setw(2) << static_cast<unsigned int>(Machine.GetDelayTimer()) << " ST=" << std::setw(2) << static_cast<unsigned int>(Machine.GetSoundTimer()) << std::dec << " Stack=" << Machine.GetStackDepth() << '\n';
+	return report.str();
+}
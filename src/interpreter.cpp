@@ -0,0 +1,725 @@
+#include "../include/interpreter.h"
+#include <algorithm>
+
+static const std::array<unsigned char, 80> LoResFontData = {
+	0xF0, 0x90, 0x90, 0x90, 0xF0, 0x20, 0x60, 0x20, 0x20, 0x70, 0xF0, 0x10, 0xF0, 0x80, 0xF0, 0xF0, 0x10, 0xF0, 0x10, 0xF0,
+	0x90, 0x90, 0xF0, 0x10, 0x10, 0xF0, 0x80, 0xF0, 0x10, 0xF0, 0xF0, 0x80, 0xF0, 0x90, 0xF0, 0xF0, 0x10, 0x20, 0x40, 0x40,
+	0xF0, 0x90, 0xF0, 0x90, 0xF0, 0xF0, 0x90, 0xF0, 0x10, 0xF0, 0xF0, 0x90, 0xF0, 0x90, 0x90, 0xE0, 0x90, 0xE0, 0x90, 0xE0,
+	0xF0, 0x80, 0x80, 0x80, 0xF0, 0xE0, 0x90, 0x90, 0x90, 0xE0, 0xF0, 0x80, 0xF0, 0x80, 0xF0, 0xF0, 0x80, 0xF0, 0x80, 0x80
+};
+
+static const std::array<unsigned char, 160> HiResFontData = {
+	0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0x18, 0x78, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF,
+	0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x06, 0x0C, 0x18, 0x18, 0x18, 0x18,
+	0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, 0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF,
+	0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC,
+	0x3C, 0xFF, 0xC3, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0xFF, 0x3C, 0xFC, 0xFE, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFE, 0xFC,
+	0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0
+};
+
+static const size_t HiResFontAddress = 0x50;
+static const size_t DisplayWidth = 128;
+static const size_t DisplayHeight = 64;
+
+BandCHIP_Assembler::Interpreter::Interpreter(ExtensionType extension, const std::vector<unsigned char> &ProgramData, bool isolate) : CurrentExtension(extension), status(InterpreterStatus::Running), isolated(isolate), high_resolution(false), plane_mask(0x1), delay_timer(0x00), sound_timer(0x00), random_state(1), program_counter(0x200), address_register(0x000), jump_register(0x0), address_register_set(!isolated)
+{
+	RegisterList.fill(0x00);
+	RegisterSetList.fill(!isolated);
+	UserFlagList.fill(0x00);
+	Memory.resize((CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64) ? 0x10000 : 0x1000, 0x00);
+	Display.resize(DisplayWidth * DisplayHeight, 0x00);
+	if (!isolated)
+	{
+		std::copy(LoResFontData.begin(), LoResFontData.end(), Memory.begin());
+		std::copy(HiResFontData.begin(), HiResFontData.end(), Memory.begin() + HiResFontAddress);
+	}
+	std::copy(ProgramData.begin(), ProgramData.begin() + std::min(ProgramData.size(), Memory.size() - 0x200), Memory.begin() + 0x200);
+}
+
+BandCHIP_Assembler::Interpreter::~Interpreter()
+{
+}
+
+void BandCHIP_Assembler::Interpreter::Jump(unsigned short address)
+{
+	program_counter = address;
+}
+
+bool BandCHIP_Assembler::Interpreter::Step()
+{
+	if (status != InterpreterStatus::Running)
+	{
+		return false;
+	}
+	bool xochip = (CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64);
+	bool hyperchip = (CurrentExtension == ExtensionType::HyperCHIP64);
+	bool superchip = (CurrentExtension == ExtensionType::SuperCHIP10 || CurrentExtension == ExtensionType::SuperCHIP11);
+	unsigned short opcode = GetOpcode();
+	size_t x = (opcode >> 8) & 0xF;
+	size_t y = (opcode >> 4) & 0xF;
+	unsigned char nn = opcode & 0xFF;
+	unsigned short nnn = opcode & 0xFFF;
+	unsigned char vx = 0x00;
+	unsigned char vy = 0x00;
+	unsigned short address = 0x000;
+	unsigned short return_address = program_counter + 2;
+	program_counter += 2;
+	switch (opcode & 0xF000)
+	{
+		case 0x0000:
+		{
+			if (opcode == 0x00EE)
+			{
+				if (Stack.size() == 0)
+				{
+					status = InterpreterStatus::StackFault;
+					break;
+				}
+				program_counter = Stack.back();
+				Stack.pop_back();
+			}
+			else if ((opcode & 0xFFE0) == 0x00C0 || opcode == 0x00E0 || opcode >= 0x00FB)
+			{
+				if (RefuseIfIsolated())
+				{
+					break;
+				}
+				size_t rows = opcode & 0xF;
+				if ((opcode & 0xFFF0) == 0x00C0)
+				{
+					Scroll(0, rows);
+				}
+				else if ((opcode & 0xFFF0) == 0x00D0)
+				{
+					Scroll(0, -static_cast<long>(rows));
+				}
+				else if (opcode == 0x00FB || opcode == 0x00FC)
+				{
+					Scroll((opcode == 0x00FB) ? 4 : -4, 0);
+				}
+				else if (opcode == 0x00FD)
+				{
+					status = InterpreterStatus::Exited;
+				}
+				else if (opcode == 0x00FE || opcode == 0x00FF)
+				{
+					high_resolution = (opcode == 0x00FF);
+					if (xochip)
+					{
+						std::fill(Display.begin(), Display.end(), 0x00);
+					}
+				}
+				else
+				{
+					for (auto &pixel : Display)
+					{
+						pixel &= ~plane_mask;
+					}
+				}
+			}
+			else
+			{
+				status = InterpreterStatus::InvalidInstruction;
+			}
+			break;
+		}
+		case 0x1000:
+		{
+			program_counter = nnn;
+			break;
+		}
+		case 0x2000:
+		{
+			if (Stack.size() >= 16)
+			{
+				status = InterpreterStatus::StackFault;
+				break;
+			}
+			Stack.push_back(return_address);
+			program_counter = nnn;
+			break;
+		}
+		case 0x3000:
+		case 0x4000:
+		{
+			if (ReadRegister(x, vx) && ((vx == nn) == ((opcode & 0xF000) == 0x3000)))
+			{
+				Skip();
+			}
+			break;
+		}
+		case 0x5000:
+		case 0x9000:
+		{
+			switch (opcode & 0xF)
+			{
+				case 0x0:
+				{
+					if (ReadRegister(x, vx) && ReadRegister(y, vy) && ((vx == vy) == ((opcode & 0xF000) == 0x5000)))
+					{
+						Skip();
+					}
+					break;
+				}
+				case 0x2:
+				case 0x3:
+				{
+					if (!xochip || (opcode & 0xF000) != 0x5000)
+					{
+						status = InterpreterStatus::InvalidInstruction;
+						break;
+					}
+					if (!ReadAddressRegister(address))
+					{
+						break;
+					}
+					size_t count = ((x > y) ? (x - y) : (y - x)) + 1;
+					for (size_t r = 0; r < count; ++r)
+					{
+						size_t reg = (x <= y) ? (x + r) : (x - r);
+						if ((opcode & 0xF) == 0x2)
+						{
+							if (!ReadRegister(reg, vx))
+							{
+								break;
+							}
+							WriteMemory(address + r, vx);
+						}
+						else
+						{
+							WriteRegister(reg, ReadMemory(address + r));
+						}
+					}
+					break;
+				}
+				default:
+				{
+					status = InterpreterStatus::InvalidInstruction;
+					break;
+				}
+			}
+			break;
+		}
+		case 0x6000:
+		{
+			WriteRegister(x, nn);
+			break;
+		}
+		case 0x7000:
+		{
+			if (ReadRegister(x, vx))
+			{
+				WriteRegister(x, vx + nn);
+			}
+			break;
+		}
+		case 0x8000:
+		{
+			unsigned char n = opcode & 0xF;
+			if ((n > 0x7 && n != 0xE && !hyperchip) || (n > 0xB && n != 0xE))
+			{
+				status = InterpreterStatus::InvalidInstruction;
+				break;
+			}
+			bool uses_vx = (n >= 0x1 && n <= 0x5) || n == 0x7 || n == 0xA || (superchip && (n == 0x6 || n == 0xE));
+			if ((uses_vx && !ReadRegister(x, vx)) || ((!superchip || (n != 0x6 && n != 0xE)) && !ReadRegister(y, vy)))
+			{
+				break;
+			}
+			switch (n)
+			{
+				case 0x0:
+				{
+					WriteRegister(x, vy);
+					break;
+				}
+				case 0x1:
+				{
+					WriteRegister(x, vx | vy);
+					break;
+				}
+				case 0x2:
+				{
+					WriteRegister(x, vx & vy);
+					break;
+				}
+				case 0x3:
+				{
+					WriteRegister(x, vx ^ vy);
+					break;
+				}
+				case 0x4:
+				{
+					WriteRegister(x, vx + vy);
+					WriteRegister(0xF, (vx + vy > 0xFF) ? 0x01 : 0x00);
+					break;
+				}
+				case 0x5:
+				{
+					WriteRegister(x, vx - vy);
+					WriteRegister(0xF, (vx >= vy) ? 0x01 : 0x00);
+					break;
+				}
+				case 0x6:
+				{
+					unsigned char source = superchip ? vx : vy;
+					WriteRegister(x, source >> 1);
+					WriteRegister(0xF, source & 0x01);
+					break;
+				}
+				case 0x7:
+				{
+					WriteRegister(x, vy - vx);
+					WriteRegister(0xF, (vy >= vx) ? 0x01 : 0x00);
+					break;
+				}
+				case 0xE:
+				{
+					unsigned char source = superchip ? vx : vy;
+					WriteRegister(x, source << 1);
+					WriteRegister(0xF, source >> 7);
+					break;
+				}
+				case 0x8:
+				{
+					WriteRegister(x, (vy >> 1) | (vy << 7));
+					break;
+				}
+				case 0x9:
+				{
+					WriteRegister(x, (vy << 1) | (vy >> 7));
+					break;
+				}
+				case 0xA:
+				{
+					WriteRegister(0xF, ((vx & vy) != 0) ? 0x01 : 0x00);
+					break;
+				}
+				case 0xB:
+				{
+					WriteRegister(x, ~vy);
+					break;
+				}
+			}
+			break;
+		}
+		case 0xA000:
+		{
+			WriteAddressRegister(nnn);
+			break;
+		}
+		case 0xB000:
+		{
+			if (ReadRegister(superchip ? x : jump_register, vx))
+			{
+				program_counter = nnn + vx;
+			}
+			break;
+		}
+		case 0xC000:
+		{
+			if (RefuseIfIsolated())
+			{
+				break;
+			}
+			random_state = random_state * 1103515245 + 12345;
+			WriteRegister(x, ((random_state >> 16) & 0xFF) & nn);
+			break;
+		}
+		case 0xD000:
+		{
+			if (RefuseIfIsolated() || !ReadRegister(x, vx) || !ReadRegister(y, vy) || !ReadAddressRegister(address))
+			{
+				break;
+			}
+			Draw(vx, vy, opcode & 0xF);
+			break;
+		}
+		case 0xE000:
+		{
+			if (nn != 0x9E && nn != 0xA1)
+			{
+				status = InterpreterStatus::InvalidInstruction;
+				break;
+			}
+			if (!RefuseIfIsolated() && ReadRegister(x, vx) && nn == 0xA1)
+			{
+				Skip();
+			}
+			break;
+		}
+		case 0xF000:
+		{
+			if (opcode == 0xF000 && xochip)
+			{
+				WriteAddressRegister((ReadMemory(program_counter) << 8) | ReadMemory(program_counter + 1));
+				program_counter += 2;
+				break;
+			}
+			switch (nn)
+			{
+				case 0x01:
+				case 0x02:
+				case 0x3C:
+				case 0x3D:
+				{
+					if (!RefuseIfIsolated())
+					{
+						plane_mask = (nn == 0x01) ? (x & (hyperchip ? 0xF : 0x3)) : plane_mask;
+					}
+					break;
+				}
+				case 0x07:
+				{
+					if (!RefuseIfIsolated())
+					{
+						WriteRegister(x, delay_timer);
+					}
+					break;
+				}
+				case 0x0A:
+				{
+					if (!RefuseIfIsolated())
+					{
+						status = InterpreterStatus::Waiting;
+					}
+					break;
+				}
+				case 0x15:
+				case 0x18:
+				case 0x3A:
+				case 0x3B:
+				{
+					if (RefuseIfIsolated() || !ReadRegister(x, vx))
+					{
+						break;
+					}
+					if (nn == 0x15)
+					{
+						delay_timer = vx;
+					}
+					else if (nn == 0x18)
+					{
+						sound_timer = vx;
+					}
+					break;
+				}
+				case 0x29:
+				case 0x30:
+				{
+					if (!RefuseIfIsolated() && ReadRegister(x, vx))
+					{
+						WriteAddressRegister((nn == 0x29) ? ((vx & 0xF) * 5) : (HiResFontAddress + (vx & 0xF) * 10));
+					}
+					break;
+				}
+				case 0x75:
+				case 0x85:
+				{
+					if (RefuseIfIsolated())
+					{
+						break;
+					}
+					for (size_t r = 0; r <= x; ++r)
+					{
+						if (nn == 0x85)
+						{
+							WriteRegister(r, UserFlagList[r]);
+						}
+						else if (ReadRegister(r, vx))
+						{
+							UserFlagList[r] = vx;
+						}
+					}
+					break;
+				}
+				case 0x1E:
+				{
+					if (ReadRegister(x, vx) && ReadAddressRegister(address))
+					{
+						WriteAddressRegister(address + vx);
+					}
+					break;
+				}
+				case 0x20:
+				case 0x21:
+				case 0xA2:
+				{
+					if (!hyperchip)
+					{
+						status = InterpreterStatus::InvalidInstruction;
+						break;
+					}
+					if (!ReadRegister(x, vx) || !ReadAddressRegister(address))
+					{
+						break;
+					}
+					address += vx;
+					unsigned short target = (ReadMemory(address) << 8) | ReadMemory(address + 1);
+					if (nn == 0xA2)
+					{
+						WriteAddressRegister(target);
+						break;
+					}
+					if (nn == 0x21)
+					{
+						if (Stack.size() >= 16)
+						{
+							status = InterpreterStatus::StackFault;
+							break;
+						}
+						Stack.push_back(return_address);
+					}
+					program_counter = target;
+					break;
+				}
+				case 0x33:
+				{
+					if (ReadRegister(x, vx) && ReadAddressRegister(address))
+					{
+						WriteMemory(address, vx / 100);
+						WriteMemory(address + 1, (vx / 10) % 10);
+						WriteMemory(address + 2, vx % 10);
+					}
+					break;
+				}
+				case 0x55:
+				case 0x65:
+				{
+					if (!ReadAddressRegister(address))
+					{
+						break;
+					}
+					for (size_t r = 0; r <= x; ++r)
+					{
+						if (nn == 0x55)
+						{
+							if (!ReadRegister(r, vx))
+							{
+								break;
+							}
+							WriteMemory(address + r, vx);
+						}
+						else
+						{
+							WriteRegister(r, ReadMemory(address + r));
+						}
+					}
+					if (status == InterpreterStatus::Running && !superchip)
+					{
+						WriteAddressRegister(address + x + 1);
+					}
+					break;
+				}
+				case 0xB1:
+				{
+					if (!hyperchip)
+					{
+						status = InterpreterStatus::InvalidInstruction;
+						break;
+					}
+					jump_register = x;
+					break;
+				}
+				default:
+				{
+					status = InterpreterStatus::InvalidInstruction;
+					break;
+				}
+			}
+			break;
+		}
+	}
+	if (status != InterpreterStatus::Running)
+	{
+		program_counter = return_address - 2;
+		return false;
+	}
+	return true;
+}
+
+void BandCHIP_Assembler::Interpreter::TickTimers()
+{
+	if (delay_timer > 0)
+	{
+		--delay_timer;
+	}
+	if (sound_timer > 0)
+	{
+		--sound_timer;
+	}
+}
+
+BandCHIP_Assembler::InterpreterStatus BandCHIP_Assembler::Interpreter::GetStatus() const
+{
+	return status;
+}
+
+unsigned short BandCHIP_Assembler::Interpreter::GetProgramCounter() const
+{
+	return program_counter;
+}
+
+unsigned short BandCHIP_Assembler::Interpreter::GetOpcode() const
+{
+	return (ReadMemory(program_counter) << 8) | ReadMemory(program_counter + 1);
+}
+
+unsigned short BandCHIP_Assembler::Interpreter::GetAddressRegister() const
+{
+	return address_register;
+}
+
+const std::array<unsigned char, 16> &BandCHIP_Assembler::Interpreter::GetRegisterList() const
+{
+	return RegisterList;
+}
+
+bool BandCHIP_Assembler::Interpreter::IsRegisterSet(size_t reg) const
+{
+	return RegisterSetList[reg & 0xF];
+}
+
+bool BandCHIP_Assembler::Interpreter::IsAddressRegisterSet() const
+{
+	return address_register_set;
+}
+
+size_t BandCHIP_Assembler::Interpreter::GetStackDepth() const
+{
+	return Stack.size();
+}
+
+unsigned char BandCHIP_Assembler::Interpreter::GetDelayTimer() const
+{
+	return delay_timer;
+}
+
+unsigned char BandCHIP_Assembler::Interpreter::GetSoundTimer() const
+{
+	return sound_timer;
+}
+
+const std::vector<unsigned char> &BandCHIP_Assembler::Interpreter::GetMemory() const
+{
+	return Memory;
+}
+
+bool BandCHIP_Assembler::Interpreter::ReadRegister(size_t reg, unsigned char &value)
+{
+	if (!RegisterSetList[reg])
+	{
+		status = InterpreterStatus::UndefinedRead;
+		return false;
+	}
+	value = RegisterList[reg];
+	return true;
+}
+
+void BandCHIP_Assembler::Interpreter::WriteRegister(size_t reg, unsigned char value)
+{
+	RegisterList[reg] = value;
+	RegisterSetList[reg] = true;
+}
+
+bool BandCHIP_Assembler::Interpreter::ReadAddressRegister(unsigned short &value)
+{
+	if (!address_register_set)
+	{
+		status = InterpreterStatus::UndefinedRead;
+		return false;
+	}
+	value = address_register;
+	return true;
+}
+
+void BandCHIP_Assembler::Interpreter::WriteAddressRegister(unsigned short value)
+{
+	address_register = value;
+	address_register_set = true;
+}
+
+unsigned char BandCHIP_Assembler::Interpreter::ReadMemory(size_t address) const
+{
+	return Memory[address & (Memory.size() - 1)];
+}
+
+void BandCHIP_Assembler::Interpreter::WriteMemory(size_t address, unsigned char value)
+{
+	Memory[address & (Memory.size() - 1)] = value;
+}
+
+void BandCHIP_Assembler::Interpreter::Skip()
+{
+	bool xochip = (CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64);
+	program_counter += (xochip && GetOpcode() == 0xF000) ? 4 : 2;
+}
+
+bool BandCHIP_Assembler::Interpreter::RefuseIfIsolated()
+{
+	if (isolated)
+	{
+		status = InterpreterStatus::Unsupported;
+	}
+	return isolated;
+}
+
+void BandCHIP_Assembler::Interpreter::Draw(size_t x, size_t y, size_t height)
+{
+	size_t width = high_resolution ? DisplayWidth : (DisplayWidth / 2);
+	size_t screen_height = high_resolution ? DisplayHeight : (DisplayHeight / 2);
+	size_t sprite_width = 8;
+	if (height == 0 && CurrentExtension != ExtensionType::CHIP8)
+	{
+		sprite_width = height = 16;
+	}
+	size_t row_size = sprite_width / 8;
+	size_t sprite_address = address_register;
+	bool collision = false;
+	x %= width;
+	y %= screen_height;
+	for (size_t p = 0; p < 4; ++p)
+	{
+		unsigned char plane = 1 << p;
+		if ((plane_mask & plane) == 0)
+		{
+			continue;
+		}
+		for (size_t row = 0; row < height; ++row)
+		{
+			for (size_t column = 0; column < sprite_width; ++column)
+			{
+				unsigned char data = ReadMemory(sprite_address + row * row_size + column / 8);
+				if ((data & (0x80 >> (column % 8))) == 0 || x + column >= width || y + row >= screen_height)
+				{
+					continue;
+				}
+				unsigned char &pixel = Display[(y + row) * DisplayWidth + x + column];
+				collision = collision || (pixel & plane) != 0;
+				pixel ^= plane;
+			}
+		}
+		sprite_address += height * row_size;
+	}
+	WriteRegister(0xF, collision ? 0x01 : 0x00);
+}
+
+void BandCHIP_Assembler::Interpreter::Scroll(long dx, long dy)
+{
+	long width = high_resolution ? DisplayWidth : (DisplayWidth / 2);
+	long height = high_resolution ? DisplayHeight : (DisplayHeight / 2);
+	std::vector<unsigned char> PreviousDisplay = Display;
+	for (long y = 0; y < height; ++y)
+	{
+		for (long x = 0; x < width; ++x)
+		{
+			long source_x = x - dx;
+			long source_y = y - dy;
+			unsigned char source = (source_x >= 0 && source_x < width && source_y >= 0 && source_y < height) ? PreviousDisplay[source_y * DisplayWidth + source_x] : 0x00;
+			unsigned char &pixel = Display[y * DisplayWidth + x];
+			pixel = (pixel & ~plane_mask) | (source & plane_mask);
+		}
+	}
+}
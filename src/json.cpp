@@ -0,0 +1,435 @@
+#include "../include/json.h"
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+
+static bool ParseJSONValue(const std::string &text, size_t &position, BandCHIP_Assembler::JSONValue &value, size_t depth);
+
+static void SkipJSONWhitespace(const std::string &text, size_t &position)
+{
+	while (position < text.size() && (text[position] == ' ' || text[position] == '\t' || text[position] == '\n' || text[position] == '\r'))
+	{
+		++position;
+	}
+}
+
+static void AppendUTF8(std::string &text, unsigned long code_point)
+{
+	if (code_point < 0x80)
+	{
+		text += static_cast<char>(code_point);
+	}
+	else if (code_point < 0x800)
+	{
+		text += static_cast<char>(0xC0 | (code_point >> 6));
+		text += static_cast<char>(0x80 | (code_point & 0x3F));
+	}
+	else if (code_point < 0x10000)
+	{
+		text += static_cast<char>(0xE0 | (code_point >> 12));
+		text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+		text += static_cast<char>(0x80 | (code_point & 0x3F));
+	}
+	else
+	{
+		text += static_cast<char>(0xF0 | (code_point >> 18));
+		text += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+		text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+		text += static_cast<char>(0x80 | (code_point & 0x3F));
+	}
+}
+
+static bool ParseJSONString(const std::string &text, size_t &position, std::string &result)
+{
+	if (position >= text.size() || text[position] != '"')
+	{
+		return false;
+	}
+	++position;
+	auto ParseHex = [&text, &position](unsigned long &code_unit)
+	{
+		if (position + 4 > text.size())
+		{
+			return false;
+		}
+		code_unit = 0;
+		for (size_t c = 0; c < 4; ++c)
+		{
+			char digit = text[position++];
+			code_unit <<= 4;
+			if (digit >= '0' && digit <= '9')
+			{
+				code_unit |= digit - '0';
+			}
+			else if (digit >= 'a' && digit <= 'f')
+			{
+				code_unit |= digit - 'a' + 10;
+			}
+			else if (digit >= 'A' && digit <= 'F')
+			{
+				code_unit |= digit - 'A' + 10;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+	while (position < text.size())
+	{
+		char c = text[position++];
+		if (c == '"')
+		{
+			return true;
+		}
+		if (c != '\\')
+		{
+			result += c;
+			continue;
+		}
+		if (position >= text.size())
+		{
+			return false;
+		}
+		char escape = text[position++];
+		switch (escape)
+		{
+			case '"':
+			case '\\':
+			case '/':
+			{
+				result += escape;
+				break;
+			}
+			case 'b':
+			{
+				result += '\b';
+				break;
+			}
+			case 'f':
+			{
+				result += '\f';
+				break;
+			}
+			case 'n':
+			{
+				result += '\n';
+				break;
+			}
+			case 'r':
+			{
+				result += '\r';
+				break;
+			}
+			case 't':
+			{
+				result += '\t';
+				break;
+			}
+			case 'u':
+			{
+				unsigned long code_point = 0;
+				if (!ParseHex(code_point))
+				{
+					return false;
+				}
+				if (code_point >= 0xD800 && code_point <= 0xDBFF && position + 6 <= text.size() && text[position] == '\\' && text[position + 1] == 'u')
+				{
+					position += 2;
+					unsigned long low_surrogate = 0;
+					if (!ParseHex(low_surrogate))
+					{
+						return false;
+					}
+					code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+				}
+				AppendUTF8(result, code_point);
+				break;
+			}
+			default:
+			{
+				return false;
+			}
+		}
+	}
+	return false;
+}
+
+static bool ParseJSONValue(const std::string &text, size_t &position, BandCHIP_Assembler::JSONValue &value, size_t depth)
+{
+	if (depth > 256)
+	{
+		return false;
+	}
+	SkipJSONWhitespace(text, position);
+	if (position >= text.size())
+	{
+		return false;
+	}
+	switch (text[position])
+	{
+		case '{':
+		{
+			value.Type = BandCHIP_Assembler::JSONType::Object;
+			++position;
+			SkipJSONWhitespace(text, position);
+			if (position < text.size() && text[position] == '}')
+			{
+				++position;
+				return true;
+			}
+			while (true)
+			{
+				SkipJSONWhitespace(text, position);
+				std::string key;
+				if (!ParseJSONString(text, position, key))
+				{
+					return false;
+				}
+				SkipJSONWhitespace(text, position);
+				if (position >= text.size() || text[position] != ':')
+				{
+					return false;
+				}
+				++position;
+				if (!ParseJSONValue(text, position, value.Object[key], depth + 1))
+				{
+					return false;
+				}
+				SkipJSONWhitespace(text, position);
+				if (position < text.size() && text[position] == ',')
+				{
+					++position;
+					continue;
+				}
+				if (position < text.size() && text[position] == '}')
+				{
+					++position;
+					return true;
+				}
+				return false;
+			}
+		}
+		case '[':
+		{
+			value.Type = BandCHIP_Assembler::JSONType::Array;
+			++position;
+			SkipJSONWhitespace(text, position);
+			if (position < text.size() && text[position] == ']')
+			{
+				++position;
+				return true;
+			}
+			while (true)
+			{
+				value.Array.push_back(BandCHIP_Assembler::JSONValue());
+				if (!ParseJSONValue(text, position, value.Array.back(), depth + 1))
+				{
+					return false;
+				}
+				SkipJSONWhitespace(text, position);
+				if (position < text.size() && text[position] == ',')
+				{
+					++position;
+					continue;
+				}
+				if (position < text.size() && text[position] == ']')
+				{
+					++position;
+					return true;
+				}
+				return false;
+			}
+		}
+		case '"':
+		{
+			value.Type = BandCHIP_Assembler::JSONType::String;
+			return ParseJSONString(text, position, value.String);
+		}
+		case 't':
+		{
+			if (text.compare(position, 4, "true") != 0)
+			{
+				return false;
+			}
+			value.Type = BandCHIP_Assembler::JSONType::Boolean;
+			value.Boolean = true;
+			position += 4;
+			return true;
+		}
+		case 'f':
+		{
+			if (text.compare(position, 5, "false") != 0)
+			{
+				return false;
+			}
+			value.Type = BandCHIP_Assembler::JSONType::Boolean;
+			value.Boolean = false;
+			position += 5;
+			return true;
+		}
+		case 'n':
+		{
+			if (text.compare(position, 4, "null") != 0)
+			{
+				return false;
+			}
+			value.Type = BandCHIP_Assembler::JSONType::Null;
+			position += 4;
+			return true;
+		}
+		default:
+		{
+			const char *start = text.c_str() + position;
+			char *end = nullptr;
+			value.Number = strtod(start, &end);
+			if (end == start)
+			{
+				return false;
+			}
+			value.Type = BandCHIP_Assembler::JSONType::Number;
+			position += end - start;
+			return true;
+		}
+	}
+}
+
+const BandCHIP_Assembler::JSONValue &BandCHIP_Assembler::JSONValue::operator[](const std::string &key) const
+{
+	static const JSONValue NullValue;
+	auto member = Object.find(key);
+	return (member != Object.end()) ? member->second : NullValue;
+}
+
+const BandCHIP_Assembler::JSONValue &BandCHIP_Assembler::JSONValue::operator[](size_t index) const
+{
+	static const JSONValue NullValue;
+	return (index < Array.size()) ? Array[index] : NullValue;
+}
+
+bool BandCHIP_Assembler::JSONValue::Has(const std::string &key) const
+{
+	return Object.find(key) != Object.end();
+}
+
+bool BandCHIP_Assembler::ParseJSON(const std::string &text, JSONValue &value)
+{
+	size_t position = 0;
+	value = JSONValue();
+	if (!ParseJSONValue(text, position, value, 0))
+	{
+		return false;
+	}
+	SkipJSONWhitespace(text, position);
+	return position == text.size();
+}
+
+std::string BandCHIP_Assembler::WriteJSON(const JSONValue &value)
+{
+	switch (value.Type)
+	{
+		case JSONType::Boolean:
+		{
+			return value.Boolean ? "true" : "false";
+		}
+		case JSONType::Number:
+		{
+			std::ostringstream number;
+			if (std::floor(value.Number) == value.Number && std::fabs(value.Number) < 1e15)
+			{
+				number << static_cast<long long>(value.Number);
+			}
+			else
+			{
+				number << std::setprecision(17) << value.Number;
+			}
+			return number.str();
+		}
+		case JSONType::String:
+		{
+			return '"' + EscapeJSONString(value.String) + '"';
+		}
+		case JSONType::Array:
+		{
+			std::string result = "[";
+			for (size_t a = 0; a < value.Array.size(); ++a)
+			{
+				if (a > 0)
+				{
+					result += ',';
+				}
+				result += WriteJSON(value.Array[a]);
+			}
+			return result + ']';
+		}
+		case JSONType::Object:
+		{
+			std::string result = "{";
+			for (auto &m : value.Object)
+			{
+				if (result.size() > 1)
+				{
+					result += ',';
+				}
+				result += '"' + EscapeJSONString(m.first) + "\":" + WriteJSON(m.second);
+			}
+			return result + '}';
+		}
+		default:
+		{
+			return "null";
+		}
+	}
+}
+
+std::string BandCHIP_Assembler::EscapeJSONString(const std::string &text)
+{
+	std::ostringstream result;
+	for (size_t c = 0; c < text.size(); ++c)
+	{
+		unsigned char character = static_cast<unsigned char>(text[c]);
+		switch (character)
+		{
+			case '"':
+			{
+				result << "\\\"";
+				break;
+			}
+			case '\\':
+			{
+				result << "\\\\";
+				break;
+			}
+			case '\n':
+			{
+				result << "\\n";
+				break;
+			}
+			case '\r':
+			{
+				result << "\\r";
+				break;
+			}
+			case '\t':
+			{
+				result << "\\t";
+				break;
+			}
+			default:
+			{
+				if (character < 0x20)
+				{
+					result << "\\u" << std::hex << std::setfill('0') << std::setw(4) << static_cast<unsigned short>(character) << std::dec;
+				}
+				else
+				{
+					result << text[c];
+				}
+				break;
+			}
+		}
+	}
+	return result.str();
+}
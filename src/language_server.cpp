@@ -0,0 +1,478 @@
+#include "../include/language_server.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cerrno>
+#ifndef _WIN32
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+static bool IsNameCharacter(char c)
+{
+	return !(isspace(static_cast<unsigned char>(c)) || c == ',' || c == ';' || c == ':' || c == '[' || c == ']' || c == '"' || c == '\0');
+}
+
+static size_t FindNameColumn(const std::string &line, const std::string &name, size_t start)
+{
+	size_t comment = line.find(';');
+	for (size_t position = line.find(name, start); position != std::string::npos && position < comment; position = line.find(name, position + 1))
+	{
+		if ((position == 0 || !IsNameCharacter(line[position - 1])) && (position + name.size() >= line.size() || !IsNameCharacter(line[position + name.size()])))
+		{
+			return position;
+		}
+	}
+	return std::string::npos;
+}
+
+BandCHIP_Assembler::LanguageServer::LanguageServer(BinaryFileCache &cache) : Cache(cache), IndexAssembler(IndexLog, cache), shutdown(false)
+{
+}
+
+BandCHIP_Assembler::LanguageServer::~LanguageServer()
+{
+}
+
+bool BandCHIP_Assembler::LanguageServer::Run()
+{
+	std::ios::sync_with_stdio(false);
+	std::string content;
+	while (ReadMessage(content))
+	{
+		JSONValue message;
+		if (!ParseJSON(content, message))
+		{
+			SendMessage("{\"jsonrpc\":\"2.0\",\"id\":null,\"error\":{\"code\":-32700,\"message\":\"Parse error\"}}");
+			continue;
+		}
+		if (message["method"].String == "exit")
+		{
+			return shutdown;
+		}
+		ProcessMessage(message);
+		if (!InputPending())
+		{
+			for (auto &d : DocumentList)
+			{
+				if (d.second.diagnostics_pending)
+				{
+					PublishDiagnostics(d.first, d.second);
+				}
+			}
+		}
+	}
+	return false;
+}
+
+bool BandCHIP_Assembler::LanguageServer::ReadMessage(std::string &content)
+{
+	size_t content_length = 0;
+	bool length_found = false;
+	std::string header;
+	while (std::getline(std::cin, header))
+	{
+		if (header.size() > 0 && header.back() == '\r')
+		{
+			header.pop_back();
+		}
+		if (header.size() == 0)
+		{
+			if (!length_found)
+			{
+				continue;
+			}
+			content.assign(content_length, '\0');
+			std::cin.read(&content[0], content_length);
+			return static_cast<size_t>(std::cin.gcount()) == content_length;
+		}
+		const std::string length_header = "Content-Length:";
+		size_t header_position = header.find(length_header);
+		if (header_position != std::string::npos)
+		{
+			std::string value = header.substr(header_position + length_header.size());
+			value.erase(0, value.find_first_not_of(' '));
+			value.erase(value.find_last_not_of(' ') + 1);
+			char *value_end = nullptr;
+			errno = 0;
+			content_length = (value.size() > 0 && isdigit(static_cast<unsigned char>(value[0]))) ? std::strtoul(value.c_str(), &value_end, 10) : 0;
+			length_found = (value_end == value.c_str() + value.size() && errno == 0 && content_length <= MaximumMessageSize);
+		}
+	}
+	return false;
+}
+
+void BandCHIP_Assembler::LanguageServer::SendMessage(const std::string &content)
+{
+	std::cout << "Content-Length: " << content.size() << "\r\n\r\n" << content;
+	std::cout.flush();
+}
+
+void BandCHIP_Assembler::LanguageServer::SendResponse(const JSONValue &id, const std::string &result)
+{
+	SendMessage("{\"jsonrpc\":\"2.0\",\"id\":" + WriteJSON(id) + ",\"result\":" + result + "}");
+}
+
+void BandCHIP_Assembler::LanguageServer::ProcessMessage(const JSONValue &message)
+{
+	const std::string &method = message["method"].String;
+	const JSONValue &params = message["params"];
+	if (method == "initialize")
+	{
+		SendResponse(message["id"], "{\"capabilities\":{\"textDocumentSync\":{\"openClose\":true,\"change\":2},\"definitionProvider\":true,\"referencesProvider\":true},\"serverInfo\":{\"name\":\"bandchip_assembler\"}}");
+	}
+	else if (method == "shutdown")
+	{
+		shutdown = true;
+		SendResponse(message["id"], "null");
+	}
+	else if (method == "textDocument/didOpen")
+	{
+		OpenDocument(params["textDocument"]["uri"].String, params["textDocument"]["text"].String);
+	}
+	else if (method == "textDocument/didChange")
+	{
+		auto document = DocumentList.find(params["textDocument"]["uri"].String);
+		if (document != DocumentList.end())
+		{
+			for (auto &c : params["contentChanges"].Array)
+			{
+				ChangeDocument(document->second, c);
+			}
+			document->second.diagnostics_pending = true;
+		}
+	}
+	else if (method == "textDocument/didClose")
+	{
+		const std::string &uri = params["textDocument"]["uri"].String;
+		DocumentList.erase(uri);
+		SendMessage("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":\"" + EscapeJSONString(uri) + "\",\"diagnostics\":[]}}");
+	}
+	else if (method == "textDocument/definition" || method == "textDocument/references")
+	{
+		const std::string &uri = params["textDocument"]["uri"].String;
+		auto document = DocumentList.find(uri);
+		if (document == DocumentList.end())
+		{
+			SendResponse(message["id"], "null");
+			return;
+		}
+		std::string name = GetNameAt(document->second, static_cast<size_t>(params["position"]["line"].Number), static_cast<size_t>(params["position"]["character"].Number));
+		if (method == "textDocument/definition")
+		{
+			SendResponse(message["id"], FindLocations(uri, document->second, name, true, false));
+		}
+		else
+		{
+			SendResponse(message["id"], FindLocations(uri, document->second, name, params["context"]["includeDeclaration"].Boolean, true));
+		}
+	}
+	else if (message.Has("id") && method.size() > 0)
+	{
+		SendMessage("{\"jsonrpc\":\"2.0\",\"id\":" + WriteJSON(message["id"]) + ",\"error\":{\"code\":-32601,\"message\":\"Method not found\"}}");
+	}
+}
+
+void BandCHIP_Assembler::LanguageServer::OpenDocument(const std::string &uri, const std::string &text)
+{
+	DocumentData &document = DocumentList[uri];
+	document = DocumentData();
+	document.stale_position = 0;
+	document.diagnostics_pending = false;
+	std::vector<std::string> NewLineList;
+	std::istringstream text_stream(text);
+	std::string line;
+	while (std::getline(text_stream, line))
+	{
+		NewLineList.push_back(line);
+	}
+	if (text.size() == 0 || text.back() == '\n')
+	{
+		NewLineList.push_back("");
+	}
+	ReplaceLines(document, 0, 0, NewLineList);
+	PublishDiagnostics(uri, document);
+}
+
+void BandCHIP_Assembler::LanguageServer::ChangeDocument(DocumentData &document, const JSONValue &change)
+{
+	if (!change.Has("range"))
+	{
+		std::vector<std::string> NewLineList;
+		std::istringstream text_stream(change["text"].String);
+		std::string line;
+		while (std::getline(text_stream, line))
+		{
+			NewLineList.push_back(line);
+		}
+		if (change["text"].String.size() == 0 || change["text"].String.back() == '\n')
+		{
+			NewLineList.push_back("");
+		}
+		ReplaceLines(document, 0, document.LineList.size(), NewLineList);
+		return;
+	}
+	size_t start_line = std::min(static_cast<size_t>(change["range"]["start"]["line"].Number), document.LineList.size() - 1);
+	size_t end_line = std::min(static_cast<size_t>(change["range"]["end"]["line"].Number), document.LineList.size() - 1);
+	const std::string &first_line = document.LineList[start_line];
+	const std::string &last_line = document.LineList[end_line];
+	size_t start_character = std::min(static_cast<size_t>(change["range"]["start"]["character"].Number), first_line.size());
+	size_t end_character = std::min(static_cast<size_t>(change["range"]["end"]["character"].Number), last_line.size());
+	std::string text = first_line.substr(0, start_character) + change["text"].String + last_line.substr(end_character);
+	std::vector<std::string> NewLineList;
+	size_t line_start = 0;
+	for (size_t line_end = text.find('\n'); line_end != std::string::npos; line_end = text.find('\n', line_start))
+	{
+		NewLineList.push_back(text.substr(line_start, line_end - line_start));
+		line_start = line_end + 1;
+	}
+	NewLineList.push_back(text.substr(line_start));
+	ReplaceLines(document, start_line, end_line - start_line + 1, NewLineList);
+}
+
+void BandCHIP_Assembler::LanguageServer::ReplaceLines(DocumentData &document, size_t first_line, size_t line_count, const std::vector<std::string> &NewLineList)
+{
+	size_t reused_count = std::min(line_count, NewLineList.size());
+	for (size_t l = 0; l < reused_count; ++l)
+	{
+		size_t line_id = document.LineIDList[first_line + l];
+		if (document.LineList[first_line + l] != NewLineList[l])
+		{
+			UnindexLine(document, line_id);
+			document.LineList[first_line + l] = NewLineList[l];
+			IndexLine(document, line_id, NewLineList[l]);
+		}
+	}
+	if (line_count == NewLineList.size())
+	{
+		return;
+	}
+	size_t position = first_line + reused_count;
+	if (line_count > NewLineList.size())
+	{
+		size_t removed_count = line_count - NewLineList.size();
+		for (size_t l = 0; l < removed_count; ++l)
+		{
+			size_t line_id = document.LineIDList[position + l];
+			UnindexLine(document, line_id);
+			document.FreeLineIDList.push_back(line_id);
+		}
+		document.LineList.erase(document.LineList.begin() + position, document.LineList.begin() + position + removed_count);
+		document.LineIDList.erase(document.LineIDList.begin() + position, document.LineIDList.begin() + position + removed_count);
+	}
+	else
+	{
+		std::vector<size_t> NewLineIDList;
+		for (size_t l = reused_count; l < NewLineList.size(); ++l)
+		{
+			size_t line_id = AllocateLine(document);
+			IndexLine(document, line_id, NewLineList[l]);
+			NewLineIDList.push_back(line_id);
+		}
+		document.LineList.insert(document.LineList.begin() + position, NewLineList.begin() + reused_count, NewLineList.end());
+		document.LineIDList.insert(document.LineIDList.begin() + position, NewLineIDList.begin(), NewLineIDList.end());
+	}
+	document.stale_position = std::min(document.stale_position, position);
+}
+
+size_t BandCHIP_Assembler::LanguageServer::AllocateLine(DocumentData &document)
+{
+	if (document.FreeLineIDList.size() > 0)
+	{
+		size_t line_id = document.FreeLineIDList.back();
+		document.FreeLineIDList.pop_back();
+		return line_id;
+	}
+	document.LineIndexList.push_back({});
+	document.LinePositionList.push_back(0);
+	return document.LineIndexList.size() - 1;
+}
+
+void BandCHIP_Assembler::LanguageServer::IndexLine(DocumentData &document, size_t line_id, const std::string &line)
+{
+	std::vector<IndexEntryData> &EntryList = document.LineIndexList[line_id];
+	EntryList.clear();
+	if (line.find_first_not_of(" \t\r") == std::string::npos)
+	{
+		return;
+	}
+	IndexLog.str("");
+	IndexLog.clear();
+	IndexAssembler.Reset();
+	IndexAssembler.SetOption("EXTENSION", "HCHIP64");
+	std::istringstream line_stream(line);
+	IndexAssembler.Assemble(line_stream);
+	size_t search_start = 0;
+	for (auto &s : IndexAssembler.GetSymbolTable())
+	{
+		size_t column = FindNameColumn(line, s.Name, search_start);
+		if (column == std::string::npos)
+		{
+			continue;
+		}
+		search_start = column + s.Name.size();
+		EntryList.push_back({ s.Name, column, true });
+		document.DefinitionMap[s.Name].push_back(line_id);
+	}
+	for (auto &r : IndexAssembler.GetLabelReferenceList())
+	{
+		size_t column = FindNameColumn(line, r.Name, search_start);
+		if (column == std::string::npos)
+		{
+			continue;
+		}
+		search_start = column + r.Name.size();
+		EntryList.push_back({ r.Name, column, false });
+		document.ReferenceMap[r.Name].push_back(line_id);
+	}
+}
+
+void BandCHIP_Assembler::LanguageServer::UnindexLine(DocumentData &document, size_t line_id)
+{
+	for (auto &e : document.LineIndexList[line_id])
+	{
+		auto &NameMap = e.IsDefinition ? document.DefinitionMap : document.ReferenceMap;
+		auto entry = NameMap.find(e.Name);
+		if (entry == NameMap.end())
+		{
+			continue;
+		}
+		auto id = std::find(entry->second.begin(), entry->second.end(), line_id);
+		if (id != entry->second.end())
+		{
+			*id = entry->second.back();
+			entry->second.pop_back();
+		}
+		if (entry->second.size() == 0)
+		{
+			NameMap.erase(entry);
+		}
+	}
+	document.LineIndexList[line_id].clear();
+}
+
+size_t BandCHIP_Assembler::LanguageServer::GetLinePosition(DocumentData &document, size_t line_id)
+{
+	for (size_t p = document.stale_position; p < document.LineIDList.size(); ++p)
+	{
+		document.LinePositionList[document.LineIDList[p]] = p;
+	}
+	document.stale_position = document.LineIDList.size();
+	return document.LinePositionList[line_id];
+}
+
+std::string BandCHIP_Assembler::LanguageServer::GetNameAt(const DocumentData &document, size_t line, size_t character)
+{
+	if (line >= document.LineList.size())
+	{
+		return "";
+	}
+	const std::string &text = document.LineList[line];
+	size_t start = std::min(character, text.size());
+	size_t end = start;
+	while (start > 0 && IsNameCharacter(text[start - 1]))
+	{
+		--start;
+	}
+	while (end < text.size() && IsNameCharacter(text[end]))
+	{
+		++end;
+	}
+	return text.substr(start, end - start);
+}
+
+std::string BandCHIP_Assembler::LanguageServer::FindLocations(const std::string &uri, DocumentData &document, const std::string &name, bool definitions, bool references)
+{
+	std::ostringstream result;
+	result << '[';
+	bool first_location = true;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		bool is_definition = (pass == 0);
+		if ((is_definition && !definitions) || (!is_definition && !references))
+		{
+			continue;
+		}
+		auto &NameMap = is_definition ? document.DefinitionMap : document.ReferenceMap;
+		auto entry = NameMap.find(name);
+		if (entry == NameMap.end())
+		{
+			continue;
+		}
+		std::vector<size_t> LineIDList = entry->second;
+		std::sort(LineIDList.begin(), LineIDList.end());
+		LineIDList.erase(std::unique(LineIDList.begin(), LineIDList.end()), LineIDList.end());
+		for (auto line_id : LineIDList)
+		{
+			size_t line = GetLinePosition(document, line_id);
+			for (auto &e : document.LineIndexList[line_id])
+			{
+				if (e.IsDefinition != is_definition || e.Name != name)
+				{
+					continue;
+				}
+				if (!first_location)
+				{
+					result << ',';
+				}
+				first_location = false;
+				result << "{\"uri\":\"" << EscapeJSONString(uri) << "\",\"range\":{\"start\":{\"line\":" << line << ",\"character\":" << e.Column << "},\"end\":{\"line\":" << line << ",\"character\":" << e.Column + e.Name.size() << "}}}";
+			}
+		}
+	}
+	result << ']';
+	return result.str();
+}
+
+void BandCHIP_Assembler::LanguageServer::PublishDiagnostics(const std::string &uri, DocumentData &document)
+{
+	std::ostringstream text;
+	for (size_t l = 0; l < document.LineList.size(); ++l)
+	{
+		text << document.LineList[l];
+		if (l + 1 < document.LineList.size())
+		{
+			text << '\n';
+		}
+	}
+	std::ostringstream diagnostic_log;
+	Assembler DiagnosticAssembler(diagnostic_log, Cache);
+	std::istringstream input_source(text.str());
+	DiagnosticAssembler.Assemble(input_source);
+	std::ostringstream notification;
+	notification << "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":\"" << EscapeJSONString(uri) << "\",\"diagnostics\":[";
+	bool first_diagnostic = true;
+	for (auto &d : DiagnosticAssembler.GetDiagnosticList())
+	{
+		size_t line = (d.LineNumber > 0) ? d.LineNumber - 1 : 0;
+		size_t line_length = (line < document.LineList.size()) ? document.LineList[line].size() : 0;
+		std::string message = d.Message;
+		while (message.size() > 0 && (message.back() == '\n' || message.back() == '\r'))
+		{
+			message.pop_back();
+		}
+		if (!first_diagnostic)
+		{
+			notification << ',';
+		}
+		first_diagnostic = false;
+		notification << "{\"range\":{\"start\":{\"line\":" << line << ",\"character\":" << std::min(d.Column, line_length) << "},\"end\":{\"line\":" << line << ",\"character\":" << line_length << "}},\"severity\":1,\"source\":\"bandchip_assembler\",\"message\":\"" << EscapeJSONString(message) << "\"}";
+	}
+	notification << "]}}";
+	SendMessage(notification.str());
+	document.diagnostics_pending = false;
+}
+
+bool BandCHIP_Assembler::LanguageServer::InputPending()
+{
+	if (std::cin.rdbuf()->in_avail() > 0)
+	{
+		return true;
+	}
+#ifndef _WIN32
+	struct pollfd poll_data = { STDIN_FILENO, POLLIN, 0 };
+	return poll(&poll_data, 1, 0) > 0;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,79 @@
+#include "../include/linker.h"
+#include <fstream>
+
+int main(int argc, char *argv[])
+{
+	std::cout << "BandCHIP Linker V0.9 - By Joshua Moss\n\n";
+	std::vector<std::string> ObjectPathList;
+	std::string OutputPath;
+	bool archive_mode = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "-o")
+		{
+			if (i + 1 < argc)
+			{
+				OutputPath = argv[++i];
+			}
+		}
+		else if (arg == "-r")
+		{
+			if (i + 1 < argc)
+			{
+				archive_mode = true;
+				OutputPath = argv[++i];
+			}
+		}
+		else
+		{
+			ObjectPathList.push_back(arg);
+		}
+	}
+	if (ObjectPathList.size() == 0 || OutputPath.size() == 0)
+	{
+		std::cout << "Format:  bandchip_link <object|archive> [<object|archive> ...] -o <output>\n";
+		std::cout << "         bandchip_link -r <archive> <object> [<object> ...]\n\n";
+		return (argc > 1) ? -1 : 0;
+	}
+	BandCHIP_Assembler::Linker CurrentLinker(std::cout);
+	for (auto &p : ObjectPathList)
+	{
+		CurrentLinker.AddObject(p);
+	}
+	if (archive_mode)
+	{
+		std::cout << "Attempting to archive " << ObjectPathList.size() << " file" << ((ObjectPathList.size() != 1) ? "s" : "") << " to " << OutputPath << "...\n";
+		std::vector<unsigned char> archive_data;
+		if (CurrentLinker.GetErrorCount() == 0 && CurrentLinker.CreateArchive(archive_data))
+		{
+			std::ofstream archive_file(OutputPath, std::ios::binary);
+			archive_file.write(reinterpret_cast<const char *>(archive_data.data()), archive_data.size());
+			if (archive_file.fail())
+			{
+				std::cout << "Unable to write to '" << OutputPath << "'.\n\n";
+				return -1;
+			}
+			std::cout << "Archiving successful!\n";
+		}
+	}
+	else
+	{
+		std::cout << "Attempting to link " << ObjectPathList.size() << " file" << ((ObjectPathList.size() != 1) ? "s" : "") << " to " << OutputPath << "...\n";
+		if (CurrentLinker.GetErrorCount() == 0 && CurrentLinker.Link())
+		{
+			std::vector<unsigned char> output_data = CurrentLinker.GetOutputData();
+			std::ofstream output_file(OutputPath, std::ios::binary);
+			output_file.write(reinterpret_cast<const char *>(output_data.data()), output_data.size());
+			if (output_file.fail())
+			{
+				std::cout << "Unable to write to '" << OutputPath << "'.\n\n";
+				return -1;
+			}
+			std::cout << "Linking successful!\n";
+		}
+	}
+	size_t error_count = CurrentLinker.GetErrorCount();
+	std::cout << '\n' << "There " << ((error_count != 1) ? "were " : "was ") << error_count << " error" << ((error_count != 1) ? "s.\n" : ".\n");
+	return (error_count == 0) ? 0 : -1;
+}
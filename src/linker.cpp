@@ -0,0 +1,266 @@
+#include "../include/linker.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+
+static bool IsLocalSymbol(const std::string &name)
+{
+	return name.size() > 0 && name[0] == '@';
+}
+
+BandCHIP_Assembler::Linker::Linker(std::ostream &log) : Log(log), error_count(0), CurrentExtension(ExtensionType::CHIP8), CurrentOutputType(OutputType::Binary)
+{
+}
+
+BandCHIP_Assembler::Linker::~Linker()
+{
+}
+
+bool BandCHIP_Assembler::Linker::AddObject(const std::string &path)
+{
+	std::ifstream object_file(path, std::ios::binary);
+	if (object_file.fail())
+	{
+		++error_count;
+		Log << "Unable to open '" << path << "'.\n";
+		return false;
+	}
+	std::vector<unsigned char> object_data((std::istreambuf_iterator<char>(object_file)), std::istreambuf_iterator<char>());
+	if (IsArchive(object_data))
+	{
+		ArchiveData CurrentArchive;
+		if (!ReadArchive(object_data, CurrentArchive))
+		{
+			++error_count;
+			Log << "'" << path << "' is not a valid archive.\n";
+			return false;
+		}
+		ArchivePathList.push_back(path);
+		ArchiveList.push_back(std::move(CurrentArchive));
+		return true;
+	}
+	ObjectData CurrentObject;
+	if (!ReadObject(object_data, CurrentObject))
+	{
+		++error_count;
+		Log << "'" << path << "' is not a valid object file.\n";
+		return false;
+	}
+	if (ObjectList.size() == 0)
+	{
+		CurrentOutputType = CurrentObject.Output;
+	}
+	CurrentExtension = std::max(CurrentExtension, CurrentObject.Extension);
+	ObjectPathList.push_back(path);
+	ObjectList.push_back(std::move(CurrentObject));
+	return true;
+}
+
+bool BandCHIP_Assembler::Linker::Link()
+{
+	std::unordered_set<std::string> DefinedSymbolList;
+	std::vector<std::string> PendingReferenceList;
+	auto AddModule = [&DefinedSymbolList, &PendingReferenceList](const ObjectData &CurrentObject)
+	{
+		for (auto &s : CurrentObject.SymbolList)
+		{
+			if (!IsLocalSymbol(s.Name))
+			{
+				DefinedSymbolList.insert(s.Name);
+			}
+		}
+		for (auto &r : CurrentObject.RelocationList)
+		{
+			if (!IsLocalSymbol(r.Name))
+			{
+				PendingReferenceList.push_back(r.Name);
+			}
+		}
+	};
+	for (auto &o : ObjectList)
+	{
+		AddModule(o);
+	}
+	std::vector<std::vector<bool>> PulledMemberList;
+	for (auto &a : ArchiveList)
+	{
+		PulledMemberList.push_back(std::vector<bool>(a.MemberList.size(), false));
+	}
+	for (size_t r = 0; r < PendingReferenceList.size(); ++r)
+	{
+		if (DefinedSymbolList.find(PendingReferenceList[r]) != DefinedSymbolList.end())
+		{
+			continue;
+		}
+		for (size_t a = 0; a < ArchiveList.size(); ++a)
+		{
+			const std::vector<std::pair<std::string, size_t>> &SymbolIndex = ArchiveList[a].SymbolIndex;
+			auto symbol = std::lower_bound(SymbolIndex.begin(), SymbolIndex.end(), PendingReferenceList[r], [](const std::pair<std::string, size_t> &entry, const std::string &name) { return entry.first < name; });
+			if (symbol == SymbolIndex.end() || symbol->first != PendingReferenceList[r])
+			{
+				continue;
+			}
+			size_t member = symbol->second;
+			if (!PulledMemberList[a][member])
+			{
+				PulledMemberList[a][member] = true;
+				ObjectData CurrentObject;
+				std::string member_path = ArchivePathList[a] + '(' + ArchiveList[a].MemberNameList[member] + ')';
+				if (!ReadObject(ArchiveList[a].MemberList[member], CurrentObject))
+				{
+					++error_count;
+					Log << "'" << member_path << "' is not a valid object file.\n";
+					break;
+				}
+				if (ObjectList.size() == 0)
+				{
+					CurrentOutputType = CurrentObject.Output;
+				}
+				CurrentExtension = std::max(CurrentExtension, CurrentObject.Extension);
+				AddModule(CurrentObject);
+				ObjectPathList.push_back(member_path);
+				ObjectList.push_back(std::move(CurrentObject));
+			}
+			break;
+		}
+	}
+	bool large_memory = (CurrentExtension == ExtensionType::XOCHIP || CurrentExtension == ExtensionType::HyperCHIP64);
+	size_t memory_limit = large_memory ? 0x10000 : 0x1000;
+	std::unordered_map<std::string, std::pair<size_t, size_t>> SymbolIndex;
+	std::vector<size_t> BaseList;
+	ProgramData.clear();
+	for (size_t o = 0; o < ObjectList.size(); ++o)
+	{
+		const ObjectData &CurrentObject = ObjectList[o];
+		if (CurrentObject.Absolute && o != 0)
+		{
+			++error_count;
+			Log << "Error in '" << ObjectPathList[o] << "' : Modules that use ORG must be linked first.\n";
+		}
+		if (CurrentObject.Align && ProgramData.size() % 2 != 0)
+		{
+			ProgramData.push_back(0x00);
+		}
+		size_t base = 0x200 + ProgramData.size();
+		BaseList.push_back(base);
+		ProgramData.insert(ProgramData.end(), CurrentObject.SectionData.begin(), CurrentObject.SectionData.end());
+		for (auto &s : CurrentObject.SymbolList)
+		{
+			size_t location = s.Location + (base - 0x200);
+			auto symbol = SymbolIndex.emplace(IsLocalSymbol(s.Name) ? s.Name + '#' + std::to_string(o) : s.Name, std::make_pair(location, o));
+			if (!symbol.second)
+			{
+				++error_count;
+				Log << "Error in '" << ObjectPathList[o] << "' : Label '" << s.Name << "' is already defined in '" << ObjectPathList[symbol.first->second.second] << "'.\n";
+			}
+		}
+	}
+	if (0x200 + ProgramData.size() > memory_limit)
+	{
+		++error_count;
+		Log << "Error: Linked program ends at 0x" << std::hex << std::uppercase << (0x200 + ProgramData.size()) << std::dec << ", past the end of memory for the current extension.\n";
+		return false;
+	}
+	for (size_t o = 0; o < ObjectList.size(); ++o)
+	{
+		for (auto &r : ObjectList[o].RelocationList)
+		{
+			auto symbol = SymbolIndex.find(IsLocalSymbol(r.Name) ? r.Name + '#' + std::to_string(o) : r.Name);
+			if (symbol == SymbolIndex.end())
+			{
+				++error_count;
+				Log << "Unresolved reference '" << r.Name << "' in '" << ObjectPathList[o] << "' at line " << r.LineNumber << ".\n";
+				continue;
+			}
+			size_t location = symbol->second.first;
+			if (location > 0xFFF && ((r.IsInstruction && !r.LongAddress) || !large_memory))
+			{
+				++error_count;
+				Log << "Error in '" << ObjectPathList[o] << "' at line " << r.LineNumber << " : Reference to '" << r.Name << "' is linked past 0xFFF.\n";
+				continue;
+			}
+			UnresolvedReferenceData Relocation = r;
+			Relocation.Address = static_cast<unsigned short>(r.Address + (BaseList[o] - 0x200));
+			PatchReference(ProgramData, Relocation, location);
+		}
+	}
+	return error_count == 0;
+}
+
+bool BandCHIP_Assembler::Linker::CreateArchive(std::vector<unsigned char> &archive_data)
+{
+	ArchiveData NewArchive;
+	for (size_t a = 0; a < ArchiveList.size(); ++a)
+	{
+		NewArchive.MemberNameList.insert(NewArchive.MemberNameList.end(), ArchiveList[a].MemberNameList.begin(), ArchiveList[a].MemberNameList.end());
+		NewArchive.MemberList.insert(NewArchive.MemberList.end(), ArchiveList[a].MemberList.begin(), ArchiveList[a].MemberList.end());
+	}
+	for (size_t o = 0; o < ObjectList.size(); ++o)
+	{
+		size_t separator = ObjectPathList[o].find_last_of('/');
+		NewArchive.MemberNameList.push_back((separator != std::string::npos) ? ObjectPathList[o].substr(separator + 1) : ObjectPathList[o]);
+		NewArchive.MemberList.push_back(WriteObject(ObjectList[o]));
+	}
+	for (size_t m = 0; m < NewArchive.MemberList.size(); ++m)
+	{
+		ObjectData CurrentObject;
+		if (!ReadObject(NewArchive.MemberList[m], CurrentObject))
+		{
+			++error_count;
+			Log << "'" << NewArchive.MemberNameList[m] << "' is not a valid object file.\n";
+			continue;
+		}
+		for (auto &s : CurrentObject.SymbolList)
+		{
+			if (!IsLocalSymbol(s.Name))
+			{
+				NewArchive.SymbolIndex.push_back(std::make_pair(s.Name, m));
+			}
+		}
+	}
+	std::sort(NewArchive.SymbolIndex.begin(), NewArchive.SymbolIndex.end());
+	for (size_t s = 1; s < NewArchive.SymbolIndex.size(); ++s)
+	{
+		if (NewArchive.SymbolIndex[s].first == NewArchive.SymbolIndex[s - 1].first)
+		{
+			++error_count;
+			Log << "Error in '" << NewArchive.MemberNameList[NewArchive.SymbolIndex[s].second] << "' : Label '" << NewArchive.SymbolIndex[s].first << "' is already defined in '" << NewArchive.MemberNameList[NewArchive.SymbolIndex[s - 1].second] << "'.\n";
+		}
+	}
+	if (error_count != 0)
+	{
+		return false;
+	}
+	archive_data = WriteArchive(NewArchive);
+	return true;
+}
+
+size_t BandCHIP_Assembler::Linker::GetErrorCount() const
+{
+	return error_count;
+}
+
+std::vector<unsigned char> BandCHIP_Assembler::Linker::GetOutputData() const
+{
+	switch (CurrentOutputType)
+	{
+		case OutputType::HexASCIIString:
+		{
+			std::ostringstream hex_data;
+			hex_data << std::hex;
+			for (size_t c = 0; c < ProgramData.size(); ++c)
+			{
+				hex_data << std::setfill('0') << std::setw(2) << static_cast<unsigned short>(ProgramData[c]);
+			}
+			std::string hex_str = hex_data.str();
+			return std::vector<unsigned char>(hex_str.begin(), hex_str.end());
+		}
+		default:
+		{
+			return ProgramData;
+		}
+	}
+}
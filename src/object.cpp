@@ -0,0 +1,233 @@
+#include "../include/object.h"
+#include <algorithm>
+
+static const unsigned char ObjectSignature[4] = { 'B', 'C', 'O', 0x01 };
+static const unsigned char ArchiveSignature[4] = { 'B', 'C', 'A', 0x01 };
+
+static void WriteObjectValue(std::vector<unsigned char> &data, unsigned long value, size_t size)
+{
+	for (size_t b = size; b > 0; --b)
+	{
+		data.push_back((value >> ((b - 1) * 8)) & 0xFF);
+	}
+}
+
+static void WriteObjectString(std::vector<unsigned char> &data, const std::string &text)
+{
+	WriteObjectValue(data, text.size(), 2);
+	data.insert(data.end(), text.begin(), text.end());
+}
+
+static bool ReadObjectValue(const std::vector<unsigned char> &data, size_t &position, unsigned long &value, size_t size)
+{
+	if (data.size() - position < size)
+	{
+		return false;
+	}
+	value = 0;
+	for (size_t b = 0; b < size; ++b)
+	{
+		value = (value << 8) | data[position++];
+	}
+	return true;
+}
+
+static bool ReadObjectString(const std::vector<unsigned char> &data, size_t &position, std::string &text)
+{
+	unsigned long length = 0;
+	if (!ReadObjectValue(data, position, length, 2) || data.size() - position < length)
+	{
+		return false;
+	}
+	text.assign(data.begin() + position, data.begin() + position + length);
+	position += length;
+	return true;
+}
+
+std::vector<unsigned char> BandCHIP_Assembler::WriteObject(const ObjectData &object)
+{
+	std::vector<unsigned char> data(ObjectSignature, ObjectSignature + sizeof(ObjectSignature));
+	data.push_back(static_cast<unsigned char>(object.Extension));
+	data.push_back(static_cast<unsigned char>(object.Output));
+	data.push_back((object.Align ? 0x01 : 0x00) | (object.Absolute ? 0x02 : 0x00));
+	data.push_back(0x00);
+	WriteObjectValue(data, object.SectionData.size(), 4);
+	data.insert(data.end(), object.SectionData.begin(), object.SectionData.end());
+	WriteObjectValue(data, object.SymbolList.size(), 4);
+	for (auto &s : object.SymbolList)
+	{
+		WriteObjectString(data, s.Name);
+		WriteObjectValue(data, s.Location, 4);
+	}
+	WriteObjectValue(data, object.RelocationList.size(), 4);
+	for (auto &r : object.RelocationList)
+	{
+		WriteObjectString(data, r.Name);
+		WriteObjectValue(data, r.LineNumber, 4);
+		WriteObjectValue(data, r.Address, 2);
+		data.push_back((r.IsInstruction ? 0x01 : 0x00) | (r.LongAddress ? 0x02 : 0x00));
+	}
+	return data;
+}
+
+bool BandCHIP_Assembler::ReadObject(const std::vector<unsigned char> &data, ObjectData &object)
+{
+	if (data.size() < sizeof(ObjectSignature) + 4 || !std::equal(ObjectSignature, ObjectSignature + sizeof(ObjectSignature), data.begin()))
+	{
+		return false;
+	}
+	size_t position = sizeof(ObjectSignature);
+	if (data[position] > static_cast<unsigned char>(ExtensionType::HyperCHIP64) || data[position + 1] > static_cast<unsigned char>(OutputType::HexASCIIString))
+	{
+		return false;
+	}
+	object.Extension = static_cast<ExtensionType>(data[position]);
+	object.Output = static_cast<OutputType>(data[position + 1]);
+	object.Align = (data[position + 2] & 0x01) != 0;
+	object.Absolute = (data[position + 2] & 0x02) != 0;
+	position += 4;
+	unsigned long section_size = 0;
+	if (!ReadObjectValue(data, position, section_size, 4) || data.size() - position < section_size)
+	{
+		return false;
+	}
+	object.SectionData.assign(data.begin() + position, data.begin() + position + section_size);
+	position += section_size;
+	unsigned long symbol_count = 0;
+	if (!ReadObjectValue(data, position, symbol_count, 4))
+	{
+		return false;
+	}
+	object.SymbolList.clear();
+	for (unsigned long s = 0; s < symbol_count; ++s)
+	{
+		Symbol CurrentSymbol = { "", SymbolType::Label, 0 };
+		unsigned long location = 0;
+		if (!ReadObjectString(data, position, CurrentSymbol.Name) || !ReadObjectValue(data, position, location, 4))
+		{
+			return false;
+		}
+		CurrentSymbol.Location = location;
+		object.SymbolList.push_back(std::move(CurrentSymbol));
+	}
+	unsigned long relocation_count = 0;
+	if (!ReadObjectValue(data, position, relocation_count, 4))
+	{
+		return false;
+	}
+	object.RelocationList.clear();
+	for (unsigned long r = 0; r < relocation_count; ++r)
+	{
+		UnresolvedReferenceData CurrentRelocation = { "", 0, 0, false, false };
+		unsigned long line_number = 0;
+		unsigned long address = 0;
+		if (!ReadObjectString(data, position, CurrentRelocation.Name) || !ReadObjectValue(data, position, line_number, 4) || !ReadObjectValue(data, position, address, 2) || position >= data.size())
+		{
+			return false;
+		}
+		CurrentRelocation.LineNumber = line_number;
+		CurrentRelocation.Address = static_cast<unsigned short>(address);
+		CurrentRelocation.IsInstruction = (data[position] & 0x01) != 0;
+		CurrentRelocation.LongAddress = (data[position] & 0x02) != 0;
+		++position;
+		if (CurrentRelocation.Address + static_cast<size_t>(CurrentRelocation.LongAddress ? 4 : 2) > object.SectionData.size())
+		{
+			return false;
+		}
+		object.RelocationList.push_back(std::move(CurrentRelocation));
+	}
+	return position == data.size();
+}
+
+bool BandCHIP_Assembler::IsArchive(const std::vector<unsigned char> &data)
+{
+	return data.size() >= sizeof(ArchiveSignature) && std::equal(ArchiveSignature, ArchiveSignature + sizeof(ArchiveSignature), data.begin());
+}
+
+std::vector<unsigned char> BandCHIP_Assembler::WriteArchive(const ArchiveData &archive)
+{
+	std::vector<unsigned char> data(ArchiveSignature, ArchiveSignature + sizeof(ArchiveSignature));
+	WriteObjectValue(data, archive.MemberList.size(), 4);
+	for (size_t m = 0; m < archive.MemberList.size(); ++m)
+	{
+		WriteObjectString(data, archive.MemberNameList[m]);
+		WriteObjectValue(data, archive.MemberList[m].size(), 4);
+		data.insert(data.end(), archive.MemberList[m].begin(), archive.MemberList[m].end());
+	}
+	WriteObjectValue(data, archive.SymbolIndex.size(), 4);
+	for (auto &s : archive.SymbolIndex)
+	{
+		WriteObjectString(data, s.first);
+		WriteObjectValue(data, s.second, 4);
+	}
+	return data;
+}
+
+bool BandCHIP_Assembler::ReadArchive(const std::vector<unsigned char> &data, ArchiveData &archive)
+{
+	if (!IsArchive(data))
+	{
+		return false;
+	}
+	size_t position = sizeof(ArchiveSignature);
+	unsigned long member_count = 0;
+	if (!ReadObjectValue(data, position, member_count, 4))
+	{
+		return false;
+	}
+	archive = ArchiveData();
+	for (unsigned long m = 0; m < member_count; ++m)
+	{
+		std::string member_name;
+		unsigned long member_size = 0;
+		if (!ReadObjectString(data, position, member_name) || !ReadObjectValue(data, position, member_size, 4) || data.size() - position < member_size)
+		{
+			return false;
+		}
+		archive.MemberNameList.push_back(std::move(member_name));
+		archive.MemberList.push_back(std::vector<unsigned char>(data.begin() + position, data.begin() + position + member_size));
+		position += member_size;
+	}
+	unsigned long symbol_count = 0;
+	if (!ReadObjectValue(data, position, symbol_count, 4))
+	{
+		return false;
+	}
+	for (unsigned long s = 0; s < symbol_count; ++s)
+	{
+		std::string symbol_name;
+		unsigned long member = 0;
+		if (!ReadObjectString(data, position, symbol_name) || !ReadObjectValue(data, position, member, 4) || member >= member_count)
+		{
+			return false;
+		}
+		if (archive.SymbolIndex.size() > 0 && !(archive.SymbolIndex.back().first < symbol_name))
+		{
+			return false;
+		}
+		archive.SymbolIndex.push_back(std::make_pair(std::move(symbol_name), static_cast<size_t>(member)));
+	}
+	return position == data.size();
+}
+
+void BandCHIP_Assembler::PatchReference(std::vector<unsigned char> &Data, const UnresolvedReferenceData &reference, size_t location)
+{
+	if (reference.IsInstruction)
+	{
+		if (reference.LongAddress)
+		{
+			Data[reference.Address + 2] = (location >> 8) & 0xFF;
+			Data[reference.Address + 3] = (location & 0xFF);
+		}
+		else
+		{
+			Data[reference.Address] = (Data[reference.Address] & 0xF0) | ((location & 0xF00) >> 8);
+			Data[reference.Address + 1] = (location & 0xFF);
+		}
+	}
+	else
+	{
+		Data[reference.Address] = (location >> 8) & 0xFF;
+		Data[reference.Address + 1] = (location & 0xFF);
+	}
+}
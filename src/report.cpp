@@ -0,0 +1,104 @@
+#include "../include/report.h"
+#include <array>
+#include <utility>
+
+static const unsigned char BlockMapSignature[4] = { 'B', 'C', 'B', 0x01 };
+static const unsigned char DecodeTableSignature[4] = { 'B', 'C', 'P', 0x01 };
+static const unsigned char PageMapSignature[4] = { 'B', 'C', 'W', 0x01 };
+static const size_t PageSize = 0x100;
+
+static const std::array<std::pair<unsigned short, unsigned short>, 60> OpcodePatternList = { {
+	{ 0xFFF0, 0x00C0 }, { 0xFFF0, 0x00D0 }, { 0xFFFF, 0x00E0 }, { 0xFFFF, 0x00EE }, { 0xFFFF, 0x00FB }, { 0xFFFF, 0x00FC },
+	{ 0xFFFF, 0x00FD }, { 0xFFFF, 0x00FE }, { 0xFFFF, 0x00FF }, { 0xF000, 0x1000 }, { 0xF000, 0x2000 }, { 0xF000, 0x3000 },
+	{ 0xF000, 0x4000 }, { 0xF00F, 0x5000 }, { 0xF00F, 0x5002 }, { 0xF00F, 0x5003 }, { 0xF000, 0x6000 }, { 0xF000, 0x7000 },
+	{ 0xF00F, 0x8000 }, { 0xF00F, 0x8001 }, { 0xF00F, 0x8002 }, { 0xF00F, 0x8003 }, { 0xF00F, 0x8004 }, { 0xF00F, 0x8005 },
+	{ 0xF00F, 0x8006 }, { 0xF00F, 0x8007 }, { 0xF00F, 0x8008 }, { 0xF00F, 0x8009 }, { 0xF00F, 0x800A }, { 0xF00F, 0x800B },
+	{ 0xF00F, 0x800E }, { 0xF00F, 0x9000 }, { 0xF000, 0xA000 }, { 0xF000, 0xB000 }, { 0xF000, 0xC000 }, { 0xF000, 0xD000 },
+	{ 0xF0FF, 0xE09E }, { 0xF0FF, 0xE0A1 }, { 0xFFFF, 0xF000 }, { 0xF0FF, 0xF001 }, { 0xFFFF, 0xF002 }, { 0xF0FF, 0xF007 },
+	{ 0xF0FF, 0xF00A }, { 0xF0FF, 0xF015 }, { 0xF0FF, 0xF018 }, { 0xF0FF, 0xF01E }, { 0xF0FF, 0xF020 }, { 0xF0FF, 0xF021 },
+	{ 0xF0FF, 0xF029 }, { 0xF0FF, 0xF030 }, { 0xF0FF, 0xF033 }, { 0xF0FF, 0xF03A }, { 0xF0FF, 0xF03B }, { 0xF0FF, 0xF03C },
+	{ 0xF0FF, 0xF03D }, { 0xF0FF, 0xF055 }, { 0xF0FF, 0xF065 }, { 0xF0FF, 0xF075 }, { 0xF0FF, 0xF085 }, { 0xF0FF, 0xF0A2 }
+} };
+
+static void WriteReportValue(std::vector<unsigned char> &data, unsigned long value, size_t size)
+{
+	for (size_t b = size; b > 0; --b)
+	{
+		data.push_back((value >> ((b - 1) * 8)) & 0xFF);
+	}
+}
+
+std::vector<unsigned char> BandCHIP_Assembler::WritePageMap(const std::vector<std::pair<size_t, size_t>> &WriteRangeList, size_t program_size)
+{
+	std::vector<unsigned char> data(PageMapSignature, PageMapSignature + sizeof(PageMapSignature));
+	size_t page_count = (0x200 + program_size + PageSize - 1) / PageSize;
+	std::vector<unsigned char> PageList(page_count, 0x01);
+	for (auto &w : WriteRangeList)
+	{
+		for (size_t p = w.first / PageSize; p <= w.second / PageSize && p < page_count; ++p)
+		{
+			PageList[p] = 0x00;
+		}
+	}
+	WriteReportValue(data, PageSize, 2);
+	WriteReportValue(data, page_count, 2);
+	data.insert(data.end(), PageList.begin(), PageList.end());
+	return data;
+}
+
+std::vector<unsigned char> BandCHIP_Assembler::WriteBlockMap(const std::vector<BasicBlockData> &BlockList)
+{
+	std::vector<unsigned char> data(BlockMapSignature, BlockMapSignature + sizeof(BlockMapSignature));
+	WriteReportValue(data, BlockList.size(), 4);
+	for (auto &b : BlockList)
+	{
+		WriteReportValue(data, 0x200 + b.Offset, 2);
+		WriteReportValue(data, b.Size, 2);
+		data.push_back(static_cast<unsigned char>(b.Exit));
+		WriteReportValue(data, b.SuccessorList.size(), 2);
+		for (auto s : b.SuccessorList)
+		{
+			WriteReportValue(data, 0x200 + s, 2);
+		}
+	}
+	return data;
+}
+
+std::vector<unsigned char> BandCHIP_Assembler::WriteDecodeTable(const std::vector<unsigned char> &ProgramData, const std::vector<InstructionLocationData> &InstructionList)
+{
+	std::vector<unsigned char> data(DecodeTableSignature, DecodeTableSignature + sizeof(DecodeTableSignature));
+	std::vector<unsigned char> Bitmap((ProgramData.size() + 7) / 8, 0x00);
+	for (auto &l : InstructionList)
+	{
+		for (size_t b = l.Offset; b < l.Offset + l.Size; ++b)
+		{
+			Bitmap[b / 8] |= (0x80 >> (b % 8));
+		}
+	}
+	WriteReportValue(data, ProgramData.size(), 4);
+	data.insert(data.end(), Bitmap.begin(), Bitmap.end());
+	WriteReportValue(data, InstructionList.size(), 4);
+	for (auto &l : InstructionList)
+	{
+		unsigned short opcode = (ProgramData[l.Offset] << 8) | ProgramData[l.Offset + 1];
+		unsigned char opcode_class = 0;
+		for (size_t p = 0; p < OpcodePatternList.size(); ++p)
+		{
+			if ((opcode & OpcodePatternList[p].first) == OpcodePatternList[p].second)
+			{
+				opcode_class = p + 1;
+				break;
+			}
+		}
+		WriteReportValue(data, 0x200 + l.Offset, 2);
+		WriteReportValue(data, opcode, 2);
+		data.push_back(opcode_class);
+		data.push_back((opcode >> 8) & 0xF);
+		data.push_back((opcode >> 4) & 0xF);
+		data.push_back(opcode & 0xF);
+		data.push_back(opcode & 0xFF);
+		WriteReportValue(data, (l.Size == 4) ? ((ProgramData[l.Offset + 2] << 8) | ProgramData[l.Offset + 3]) : (opcode & 0xFFF), 2);
+		data.push_back(l.Size);
+	}
+	return data;
+}
@@ -0,0 +1,389 @@
+#include "../include/server.h"
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <csignal>
+#include <cerrno>
+#endif
+
+#ifndef _WIN32
+static volatile sig_atomic_t stop_requested = 0;
+static int signal_wake_fd = -1;
+
+static void RequestStop(int)
+{
+	stop_requested = 1;
+	char wake_data = 0;
+	ssize_t length = write(signal_wake_fd, &wake_data, 1);
+	static_cast<void>(length);
+}
+#endif
+
+BandCHIP_Assembler::Server::Server(const std::string &socket_path, BinaryFileCache &cache) : SocketPath(socket_path), Cache(cache), stopping(false), wake_fd(-1)
+{
+}
+
+BandCHIP_Assembler::Server::~Server()
+{
+}
+
+bool BandCHIP_Assembler::Server::Run()
+{
+#ifndef _WIN32
+	sockaddr_un address = {};
+	if (SocketPath.size() >= sizeof(address.sun_path))
+	{
+		std::cout << "Socket path '" << SocketPath << "' is too long.\n\n";
+		return false;
+	}
+	int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (server_fd < 0)
+	{
+		std::cout << "Unable to create the server socket.\n\n";
+		return false;
+	}
+	address.sun_family = AF_UNIX;
+	SocketPath.copy(address.sun_path, SocketPath.size());
+	unlink(SocketPath.c_str());
+	if (bind(server_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || chmod(SocketPath.c_str(), S_IRUSR | S_IWUSR) != 0 || listen(server_fd, 64) != 0)
+	{
+		std::cout << "Unable to listen on '" << SocketPath << "'.\n\n";
+		close(server_fd);
+		return false;
+	}
+	int wake_pipe[2];
+	if (pipe(wake_pipe) != 0)
+	{
+		std::cout << "Unable to create the server wake pipe.\n\n";
+		close(server_fd);
+		unlink(SocketPath.c_str());
+		return false;
+	}
+	fcntl(wake_pipe[0], F_SETFL, O_NONBLOCK);
+	fcntl(wake_pipe[1], F_SETFL, O_NONBLOCK);
+	wake_fd = wake_pipe[1];
+	stopping = false;
+	stop_requested = 0;
+	signal_wake_fd = wake_pipe[1];
+	signal(SIGPIPE, SIG_IGN);
+	auto PreviousInterruptHandler = signal(SIGINT, RequestStop);
+	auto PreviousTerminateHandler = signal(SIGTERM, RequestStop);
+	size_t worker_count = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::thread> WorkerList;
+	for (size_t w = 0; w < worker_count; ++w)
+	{
+		WorkerList.push_back(std::thread([this]()
+		{
+			std::ostringstream worker_log;
+			Assembler WorkerAssembler(worker_log, Cache);
+			while (true)
+			{
+				std::pair<int, std::string> Connection;
+				{
+					std::unique_lock<std::mutex> lock(ConnectionMutex);
+					ConnectionCondition.wait(lock, [this]() { return stopping || !ConnectionQueue.empty(); });
+					if (stopping)
+					{
+						return;
+					}
+					Connection = std::move(ConnectionQueue.front());
+					ConnectionQueue.pop();
+					ActiveList.push_back(Connection.first);
+				}
+				int client_fd = Connection.first;
+				bool keep_open = ServeRequest(client_fd, Connection.second, WorkerAssembler, worker_log);
+				{
+					std::lock_guard<std::mutex> lock(ConnectionMutex);
+					ActiveList.erase(std::find(ActiveList.begin(), ActiveList.end(), client_fd));
+					if (keep_open && !stopping)
+					{
+						ReturnList.push_back(client_fd);
+						client_fd = -1;
+					}
+				}
+				if (client_fd >= 0)
+				{
+					close(client_fd);
+					continue;
+				}
+				char wake_data = 0;
+				while (write(wake_fd, &wake_data, 1) < 0 && errno == EINTR)
+				{
+				}
+			}
+		}));
+	}
+	std::cout << "Listening on '" << SocketPath << "' with " << worker_count << " worker thread" << ((worker_count != 1) ? "s" : "") << " (press Ctrl+C to stop)...\n\n";
+	std::vector<int> IdleList;
+	std::map<int, std::string> InputList;
+	auto QueueRequest = [this, &InputList](int client_fd)
+	{
+		std::string &Input = InputList[client_fd];
+		if (Input.size() < 4)
+		{
+			return false;
+		}
+		size_t request_size = (static_cast<size_t>(static_cast<unsigned char>(Input[0])) << 24) | (static_cast<unsigned char>(Input[1]) << 16) | (static_cast<unsigned char>(Input[2]) << 8) | static_cast<unsigned char>(Input[3]);
+		if (Input.size() < 4 + request_size)
+		{
+			return false;
+		}
+		ConnectionQueue.push({ client_fd, Input.substr(4, request_size) });
+		Input.erase(0, 4 + request_size);
+		return true;
+	};
+	auto IsOversized = [this, &InputList](int client_fd)
+	{
+		const std::string &Input = InputList[client_fd];
+		return Input.size() >= 4 && ((static_cast<size_t>(static_cast<unsigned char>(Input[0])) << 24) | (static_cast<unsigned char>(Input[1]) << 16) | (static_cast<unsigned char>(Input[2]) << 8) | static_cast<unsigned char>(Input[3])) > MaximumRequestSize;
+	};
+	bool interrupted = false;
+	while (true)
+	{
+		if (stop_requested)
+		{
+			std::cout << "Stopping the server.\n\n";
+			interrupted = true;
+			break;
+		}
+		std::vector<pollfd> PollList = { { server_fd, POLLIN, 0 }, { wake_pipe[0], POLLIN, 0 } };
+		for (auto fd : IdleList)
+		{
+			PollList.push_back({ fd, POLLIN, 0 });
+		}
+		if (poll(PollList.data(), PollList.size(), -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			std::cout << "Unable to wait for requests on '" << SocketPath << "'.\n\n";
+			break;
+		}
+		{
+			std::lock_guard<std::mutex> lock(ConnectionMutex);
+			for (size_t p = 2; p < PollList.size(); ++p)
+			{
+				int client_fd = PollList[p].fd;
+				if (PollList[p].revents == 0)
+				{
+					continue;
+				}
+				char read_data[0x1000];
+				ssize_t length = read(client_fd, read_data, sizeof(read_data));
+				if (length < 0 && (errno == EINTR || errno == EAGAIN))
+				{
+					continue;
+				}
+				if (length > 0)
+				{
+					InputList[client_fd].append(read_data, length);
+				}
+				if (length <= 0 || IsOversized(client_fd))
+				{
+					IdleList.erase(std::find(IdleList.begin(), IdleList.end(), client_fd));
+					InputList.erase(client_fd);
+					close(client_fd);
+				}
+				else if (QueueRequest(client_fd))
+				{
+					IdleList.erase(std::find(IdleList.begin(), IdleList.end(), client_fd));
+				}
+			}
+			if (PollList[1].revents != 0)
+			{
+				char wake_data[64];
+				while (read(wake_pipe[0], wake_data, sizeof(wake_data)) > 0)
+				{
+				}
+				for (auto fd : ReturnList)
+				{
+					if (IsOversized(fd))
+					{
+						InputList.erase(fd);
+						close(fd);
+					}
+					else if (!QueueRequest(fd))
+					{
+						IdleList.push_back(fd);
+					}
+				}
+				ReturnList.clear();
+			}
+		}
+		ConnectionCondition.notify_all();
+		if (PollList[0].revents != 0)
+		{
+			int client_fd = accept(server_fd, nullptr, nullptr);
+			if (client_fd < 0)
+			{
+				if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN)
+				{
+					continue;
+				}
+				std::cout << "Unable to accept connections on '" << SocketPath << "'.\n\n";
+				break;
+			}
+			fcntl(client_fd, F_SETFL, O_NONBLOCK);
+			IdleList.push_back(client_fd);
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(ConnectionMutex);
+		stopping = true;
+		for (auto fd : ActiveList)
+		{
+			shutdown(fd, SHUT_RDWR);
+		}
+	}
+	ConnectionCondition.notify_all();
+	for (auto &w : WorkerList)
+	{
+		w.join();
+	}
+	signal(SIGINT, PreviousInterruptHandler);
+	signal(SIGTERM, PreviousTerminateHandler);
+	signal_wake_fd = -1;
+	for (; !ConnectionQueue.empty(); ConnectionQueue.pop())
+	{
+		close(ConnectionQueue.front().first);
+	}
+	IdleList.insert(IdleList.end(), ReturnList.begin(), ReturnList.end());
+	ReturnList.clear();
+	for (auto fd : IdleList)
+	{
+		close(fd);
+	}
+	close(wake_pipe[0]);
+	close(wake_pipe[1]);
+	wake_fd = -1;
+	close(server_fd);
+	unlink(SocketPath.c_str());
+	return interrupted;
+#else
+	std::cout << "Server mode is not supported on this platform.\n\n";
+	return false;
+#endif
+}
+
+bool BandCHIP_Assembler::Server::ServeRequest(int client_fd, const std::string &request, Assembler &WorkerAssembler, std::ostringstream &worker_log)
+{
+	std::string response = ProcessRequest(request, WorkerAssembler, worker_log);
+#ifndef _WIN32
+	size_t response_size = response.size();
+	unsigned char response_length_data[4] = {
+		static_cast<unsigned char>(response_size >> 24), static_cast<unsigned char>(response_size >> 16),
+		static_cast<unsigned char>(response_size >> 8), static_cast<unsigned char>(response_size)
+	};
+	response.insert(0, reinterpret_cast<const char *>(response_length_data), sizeof(response_length_data));
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ResponseTimeout);
+	const char *buffer = response.data();
+	size_t size = response.size();
+	while (size > 0)
+	{
+		auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+		pollfd client_poll = { client_fd, POLLOUT, 0 };
+		if (remaining <= 0 || (poll(&client_poll, 1, static_cast<int>(remaining)) < 0 && errno != EINTR))
+		{
+			return false;
+		}
+		ssize_t length = write(client_fd, buffer, size);
+		if (length < 0 && (errno == EINTR || errno == EAGAIN))
+		{
+			continue;
+		}
+		if (length <= 0)
+		{
+			return false;
+		}
+		buffer += length;
+		size -= length;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::string BandCHIP_Assembler::Server::ProcessRequest(const std::string &request, Assembler &WorkerAssembler, std::ostringstream &worker_log)
+{
+	worker_log.str("");
+	worker_log.clear();
+	WorkerAssembler.Reset();
+	std::string path = "";
+	size_t position = 0;
+	bool valid_request = true;
+	while (position < request.size())
+	{
+		size_t line_end = request.find('\n', position);
+		if (line_end == std::string::npos)
+		{
+			line_end = request.size();
+		}
+		std::string line = request.substr(position, line_end - position);
+		position = line_end + 1;
+		if (line.size() > 0 && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+		if (line.size() == 0)
+		{
+			break;
+		}
+		size_t separator = line.find(' ');
+		std::string option = line.substr(0, separator);
+		std::string value = (separator != std::string::npos) ? line.substr(separator + 1) : "";
+		if (option == "PATH")
+		{
+			path = value;
+		}
+		else if (!WorkerAssembler.SetOption(option, value))
+		{
+			worker_log << "Invalid request option '" << line << "'.\n";
+			valid_request = false;
+		}
+	}
+	bool success = false;
+	if (valid_request)
+	{
+		if (path.size() > 0)
+		{
+			std::ifstream input_file(path);
+			if (input_file.fail())
+			{
+				worker_log << "Unable to open '" << path << "'.\n";
+			}
+			else
+			{
+				success = WorkerAssembler.Assemble(input_file);
+			}
+		}
+		else
+		{
+			std::istringstream input_source((position < request.size()) ? request.substr(position) : "");
+			success = WorkerAssembler.Assemble(input_source);
+		}
+	}
+	std::vector<unsigned char> output_data;
+	if (success)
+	{
+		output_data = WorkerAssembler.GetOutputData();
+	}
+	std::string log_data = worker_log.str();
+	std::ostringstream response;
+	response << "STATUS " << (success ? "OK" : "ERROR") << '\n';
+	response << "ERRORS " << (valid_request ? WorkerAssembler.GetErrorCount() : 1) << '\n';
+	response << "LOG " << log_data.size() << '\n' << log_data;
+	response << "DATA " << output_data.size() << '\n';
+	response.write(reinterpret_cast<const char *>(output_data.data()), output_data.size());
+	return response.str();
+}
@@ -0,0 +1,14 @@
+JP Start
+Copy:
+DB 3, 4
+Start:
+LD V0, 2
+LD I, Table1
+ADD I, V0
+LD V0, [I]
+Loop:
+JP Loop
+Table1:
+DB 1, 2
+Table2:
+DB 3, 4
@@ -0,0 +1,14 @@
+LD I, Ship
+DRW V0, V1, 4
+LD I, Enemy
+DRW V2, V3, 4
+LD I, Wall
+DRW V4, V5, 4
+Loop:
+JP Loop
+Ship:
+DB 0x18, 0x3C, 0x7E, 0xFF
+Enemy:
+DB 0x18, 0x3C, 0x7E, 0xFF
+Wall:
+DB 0xFF, 0x81, 0x81, 0xFF
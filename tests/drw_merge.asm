@@ -0,0 +1,15 @@
+ALIGN OFF
+LD V0, 8
+LD V1, 4
+LD I, Top
+DRW V0, V1, 4
+ADD V1, 4
+LD I, Bottom
+DRW V0, V1, 4
+LD VF, 0
+Loop:
+JP Loop
+Top:
+DB 0x3C, 0x42, 0x81, 0x81
+Bottom:
+DB 0x81, 0x81, 0x42, 0x3C
@@ -0,0 +1,8 @@
+CALL Step
+CALL Step
+Loop:
+JP Loop
+Step:
+ADD V0, 1
+ADD V1, 2
+RET
@@ -0,0 +1,3 @@
+CALL Draw
+Loop:
+JP Loop
@@ -0,0 +1,6 @@
+Draw:
+LD I, Ball
+DRW V0, V1, 2
+RET
+Ball:
+DB 0x60, 0x60
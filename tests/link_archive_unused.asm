@@ -0,0 +1,3 @@
+Unused:
+CLS
+RET
@@ -0,0 +1,13 @@
+LD V0, 1
+LD V1, 2
+ADD V0, V1
+LD V2, 3
+LD V0, 1
+LD V1, 2
+ADD V0, V1
+LD V3, 4
+LD V0, 1
+LD V1, 2
+ADD V0, V1
+Loop:
+JP Loop
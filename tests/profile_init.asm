@@ -0,0 +1,14 @@
+Start:
+CALL Cold
+JP Hot
+Cold:
+LD V1, 1
+RET
+Hot:
+LD V3, 3
+INIT_BEGIN
+LD V4, 5
+ADD V4, 2
+INIT_END
+Loop:
+JP Loop
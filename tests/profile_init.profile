@@ -0,0 +1 @@
+Hot 1000
@@ -0,0 +1,13 @@
+Start:
+CALL Cold
+CALL Hot
+Loop:
+JP Loop
+Cold:
+LD V1, 1
+RET
+Table:
+DB 1, 2
+Hot:
+LD V2, 2
+RET
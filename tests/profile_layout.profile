@@ -0,0 +1,2 @@
+Hot 1000
+Cold 1
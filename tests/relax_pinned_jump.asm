@@ -0,0 +1,8 @@
+EXTENSION XOCHIP
+LD I, Far
+JP 0x204
+CLS
+EXIT
+ORG 0x1000
+Far:
+DB 1
@@ -0,0 +1,9 @@
+EXTENSION XOCHIP
+LD I, Sprite
+DRW V0, V1, 2
+Loop:
+JP Loop
+RELOCATABLE ON
+Sprite:
+DB 0xFF, 0x81
+RELOCATABLE OFF
@@ -0,0 +1,58 @@
+# Assembles SOURCE with ASSEMBLER and checks the result.
+# EXPECTED_HEX holds the expected output bytes as lowercase hex (a
+# regular expression, so runs of padding can be written as (00)+),
+# EXPECTED_ERROR a message the assembler log must contain on failure,
+# and EXPECTED_LOG a message the log must contain either way.
+# With MODULES, SOURCE and each listed module next to it are assembled
+# with -c and linked by LINKER, through an archive of the modules when
+# ARCHIVE is set.  With LSP, SOURCE is fed to the language server.
+get_filename_component(name "${SOURCE}" NAME_WE)
+get_filename_component(directory "${SOURCE}" DIRECTORY)
+set(output "${CMAKE_CURRENT_BINARY_DIR}/${name}.ch8")
+file(REMOVE "${output}")
+separate_arguments(option_list UNIX_COMMAND "${OPTIONS}")
+if (LSP)
+	execute_process(COMMAND "${ASSEMBLER}" --lsp INPUT_FILE "${SOURCE}" OUTPUT_VARIABLE log ERROR_VARIABLE log)
+elseif (DEFINED MODULES)
+	separate_arguments(module_list UNIX_COMMAND "${MODULES}")
+	set(log "")
+	set(object_list "")
+	foreach(module ${name} ${module_list})
+		execute_process(COMMAND "${ASSEMBLER}" -c "${directory}/${module}.asm" -o "${CMAKE_CURRENT_BINARY_DIR}/${module}.o" ${option_list} OUTPUT_VARIABLE module_log ERROR_VARIABLE module_log)
+		string(APPEND log "${module_log}")
+		list(APPEND object_list "${CMAKE_CURRENT_BINARY_DIR}/${module}.o")
+	endforeach()
+	if (ARCHIVE)
+		list(GET object_list 0 main_object)
+		list(REMOVE_AT object_list 0)
+		set(archive "${CMAKE_CURRENT_BINARY_DIR}/${name}.lib")
+		file(REMOVE "${archive}")
+		execute_process(COMMAND "${LINKER}" -r "${archive}" ${object_list} OUTPUT_VARIABLE archive_log ERROR_VARIABLE archive_log)
+		string(APPEND log "${archive_log}")
+		set(object_list "${main_object}" "${archive}")
+	endif()
+	execute_process(COMMAND "${LINKER}" ${object_list} -o "${output}" OUTPUT_VARIABLE link_log ERROR_VARIABLE link_log)
+	string(APPEND log "${link_log}")
+else()
+	execute_process(COMMAND "${ASSEMBLER}" "${SOURCE}" -o "${output}" ${option_list} OUTPUT_VARIABLE log ERROR_VARIABLE log)
+endif()
+if (DEFINED EXPECTED_ERROR)
+	string(FIND "${log}" "${EXPECTED_ERROR}" position)
+	if (position EQUAL -1)
+		message(FATAL_ERROR "Expected '${EXPECTED_ERROR}' in the log:\n${log}")
+	endif()
+elseif (DEFINED EXPECTED_HEX)
+	if (NOT EXISTS "${output}")
+		message(FATAL_ERROR "Assembly failed:\n${log}")
+	endif()
+	file(READ "${output}" data HEX)
+	if (NOT data MATCHES "^${EXPECTED_HEX}$")
+		message(FATAL_ERROR "Expected ${EXPECTED_HEX} but got ${data}.\n${log}")
+	endif()
+endif()
+if (DEFINED EXPECTED_LOG)
+	string(FIND "${log}" "${EXPECTED_LOG}" position)
+	if (position EQUAL -1)
+		message(FATAL_ERROR "Expected '${EXPECTED_LOG}' in the log:\n${log}")
+	endif()
+endif()
@@ -0,0 +1,19 @@
+EXTENSION SCHIP11
+LD V3, 4
+SWITCH V3, Case0, Case1, Case2, Case3, Case4
+Case0:
+LD V9, 0x0A
+JP Done
+Case1:
+LD V9, 0x0B
+JP Done
+Case2:
+LD V9, 0x0C
+JP Done
+Case3:
+LD V9, 0x0D
+JP Done
+Case4:
+LD V9, 0x0E
+Done:
+JP Done